@@ -0,0 +1,151 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2014-2018 David Medina and Tim Warburton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ */
+
+#ifndef OCCA_BENCHMARKS_BENCHMARK_HEADER
+#define OCCA_BENCHMARKS_BENCHMARK_HEADER
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "occa.hpp"
+#include "occa/tools/json.hpp"
+#include "occa/tools/sys.hpp"
+
+namespace bench {
+  //---[ timer ]------------------------
+  // Loops until both [minIterations] and [minSeconds] are reached
+  //
+  //   bench::timer timer;
+  //   while (timer.next()) {
+  //     ...
+  //   }
+  class timer {
+  public:
+    int minIterations;
+    double minSeconds;
+
+    int iterations;
+    double startTime, lastTime;
+    double minTime;
+
+    inline timer(const int minIterations_ = 10,
+                 const double minSeconds_ = 0.25) :
+      minIterations(minIterations_),
+      minSeconds(minSeconds_),
+      iterations(-1),
+      startTime(0),
+      lastTime(0),
+      minTime(0) {}
+
+    inline bool next() {
+      const double now = occa::sys::currentTime();
+      if (iterations < 0) {
+        iterations = 0;
+        startTime = lastTime = now;
+        return true;
+      }
+      const double time = now - lastTime;
+      if (!iterations || (time < minTime)) {
+        minTime = time;
+      }
+      lastTime = now;
+      ++iterations;
+      return ((iterations < minIterations) ||
+              ((now - startTime) < minSeconds));
+    }
+
+    inline double meanTime() const {
+      return (iterations > 0
+              ? ((lastTime - startTime) / iterations)
+              : 0);
+    }
+  };
+  //====================================
+
+  //---[ results ]----------------------
+  // Prints one JSON object per suite run:
+  //   { "suite", "device", "mode", "results": [
+  //       { "name", "params", "iterations", "meanSeconds", "minSeconds",
+  //         ["bytesPerSecond"] }
+  //   ]}
+  class results {
+  public:
+    occa::json output;
+
+    inline results(const std::string &suite,
+                   occa::device device) {
+      output.asObject();
+      output["suite"] = suite;
+      output["results"].asArray();
+      if (device.isInitialized()) {
+        output["mode"]   = device.mode();
+        output["device"] = (const occa::json&) device.properties();
+      }
+    }
+
+    inline occa::json& add(const std::string &name,
+                           const occa::json &params,
+                           const timer &t,
+                           const occa::udim_t bytesPerIteration = 0) {
+      occa::json entry;
+      entry.asObject();
+      entry["name"]        = name;
+      entry["params"]      = params;
+      entry["params"].asObject();
+      entry["iterations"]  = t.iterations;
+      entry["meanSeconds"] = t.meanTime();
+      entry["minSeconds"]  = t.minTime;
+      if (bytesPerIteration && (t.meanTime() > 0)) {
+        entry["bytesPerSecond"] = (bytesPerIteration / t.meanTime());
+      }
+      occa::jsonArray &entries = output["results"].array();
+      entries.push_back(entry);
+      return entries.back();
+    }
+
+    inline void print() const {
+      std::cout << output.toString(0) << '\n';
+    }
+  };
+  //====================================
+
+  //---[ Helpers ]----------------------
+  // Suites take the device properties as their first argument
+  inline occa::device getDevice(const int argc, const char **argv) {
+    return occa::device(occa::properties((argc > 1)
+                                         ? argv[1]
+                                         : "mode: 'Serial'"));
+  }
+
+  // Integers are stored as int, occa::json prints 64-bit ones with an L suffix
+  inline occa::json param(const std::string &key,
+                          const occa::json &value) {
+    occa::json params;
+    params.asObject();
+    params[key] = value;
+    return params;
+  }
+  //====================================
+}
+
+#endif
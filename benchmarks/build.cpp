@@ -0,0 +1,84 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2014-2018 David Medina and Tim Warburton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ */
+
+#include <sstream>
+
+#include "benchmark.hpp"
+
+static const char *kernelSource =
+  "kernel void addVectors(const int entries,\n"
+  "                       const float *a,\n"
+  "                       const float *b,\n"
+  "                       float *ab) {\n"
+  "  for (int i = 0; i < entries; ++i; tile(16)) {\n"
+  "    if (i < entries) {\n"
+  "      ab[i] = a[i] + b[i];\n"
+  "    }\n"
+  "  }\n"
+  "}\n";
+
+// buildKernel latency
+//   cold   : new hash, parses and runs the backend compiler
+//   disk   : new device, loads the cached binary
+//   memory : same device, returns the kernel it already built
+int main(const int argc, const char **argv) {
+  occa::device device = bench::getDevice(argc, argv);
+  bench::results results("build", device);
+
+  const occa::properties deviceProps = device.properties();
+
+  // Unique per run so the first build is never cached
+  std::stringstream ss;
+  ss << occa::sys::currentTime();
+  const std::string runId = ss.str();
+
+  int coldBuilds = 0;
+  bench::timer coldTimer(3, 0);
+  while (coldTimer.next()) {
+    occa::properties props;
+    props["defines/BENCHMARK_RUN"] = runId;
+    props["defines/BENCHMARK_BUILD"] = coldBuilds++;
+    device.buildKernelFromString(kernelSource, "addVectors", props);
+  }
+  results.add("buildKernel", bench::param("cache", std::string("cold")), coldTimer);
+
+  occa::properties props;
+  props["defines/BENCHMARK_RUN"] = runId;
+  props["defines/BENCHMARK_BUILD"] = 0;
+
+  bench::timer diskTimer(10);
+  while (diskTimer.next()) {
+    occa::device newDevice(deviceProps);
+    newDevice.buildKernelFromString(kernelSource, "addVectors", props);
+    newDevice.free();
+  }
+  results.add("buildKernel", bench::param("cache", std::string("disk")), diskTimer);
+
+  bench::timer memoryTimer(100);
+  while (memoryTimer.next()) {
+    device.buildKernelFromString(kernelSource, "addVectors", props);
+  }
+  results.add("buildKernel", bench::param("cache", std::string("memory")), memoryTimer);
+
+  results.print();
+  return 0;
+}
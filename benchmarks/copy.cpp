@@ -0,0 +1,74 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2014-2018 David Medina and Tim Warburton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ */
+
+#include <cstring>
+
+#include "benchmark.hpp"
+
+// Copy bandwidth between the host and the device, and within the device
+int main(const int argc, const char **argv) {
+  occa::device device = bench::getDevice(argc, argv);
+  bench::results results("copy", device);
+
+  const occa::udim_t sizes[4] = {
+    4 << 10,
+    1 << 20,
+    16 << 20,
+    256 << 20
+  };
+  const occa::udim_t maxBytes = sizes[3];
+
+  char *host = new char[maxBytes];
+  ::memset(host, 1, maxBytes);
+
+  occa::memory src  = device.malloc(maxBytes, host);
+  occa::memory dest = device.malloc(maxBytes);
+
+  for (int i = 0; i < 4; ++i) {
+    const occa::udim_t bytes = sizes[i];
+    const occa::json params = bench::param("bytes", (int) bytes);
+
+    bench::timer toDevice;
+    while (toDevice.next()) {
+      src.copyFrom(host, bytes);
+    }
+    results.add("host-to-device", params, toDevice, bytes);
+
+    bench::timer toHost;
+    while (toHost.next()) {
+      src.copyTo(host, bytes);
+    }
+    results.add("device-to-host", params, toHost, bytes);
+
+    bench::timer onDevice;
+    while (onDevice.next()) {
+      dest.copyFrom(src, bytes);
+      device.finish();
+    }
+    results.add("device-to-device", params, onDevice, bytes);
+  }
+
+  delete [] host;
+
+  results.print();
+  return 0;
+}
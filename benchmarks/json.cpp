@@ -0,0 +1,94 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2014-2018 David Medina and Tim Warburton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ */
+
+#include <sstream>
+
+#include "benchmark.hpp"
+#include "occa/tools/env.hpp"
+#include "occa/tools/io.hpp"
+
+// Builds a build-info.json style object with [kernelCount] kernels
+occa::json buildInfo(occa::device &device, const int kernelCount) {
+  occa::json info;
+  info["date"] = "2018/01/01 00:00:00";
+  info["info/device"] = device.properties();
+  info["info/kernel/hash"] = occa::hash(kernelCount).toFullString();
+  info["info/kernel/props"] = device.kernelProperties();
+
+  occa::json &metadata = info["info/kernel/metadata"].asArray();
+  for (int k = 0; k < kernelCount; ++k) {
+    std::stringstream ss;
+    ss << "kernel" << k;
+
+    occa::json kernel;
+    kernel["name"]          = ss.str();
+    kernel["baseName"]      = ss.str();
+    kernel["nestedKernels"] = 1;
+    occa::json &args = kernel["argumentInfos"].asArray();
+    for (int i = 0; i < 4; ++i) {
+      occa::json arg;
+      arg["isConst"] = (bool) (i % 2);
+      arg["pos"]     = i;
+      args += arg;
+    }
+    metadata += kernel;
+  }
+  return info;
+}
+
+// JSON parsing and reading of build-info files
+int main(const int argc, const char **argv) {
+  occa::device device = bench::getDevice(argc, argv);
+  bench::results results("json", device);
+
+  const int kernelCounts[3] = { 1, 10, 1000 };
+
+  for (int i = 0; i < 3; ++i) {
+    const int kernelCount = kernelCounts[i];
+
+    std::stringstream ss;
+    ss << occa::env::OCCA_CACHE_DIR << "benchmarks/build-info_" << kernelCount << ".json";
+    const std::string filename = ss.str();
+    const std::string content = buildInfo(device, kernelCount).toString();
+    occa::io::write(filename, content);
+
+    occa::json params;
+    params.asObject();
+    params["kernels"] = kernelCount;
+    params["bytes"]   = (int) content.size();
+
+    bench::timer parseTimer;
+    while (parseTimer.next()) {
+      occa::json::parse(content);
+    }
+    results.add("parse", params, parseTimer, content.size());
+
+    bench::timer readTimer;
+    while (readTimer.next()) {
+      occa::json::read(filename);
+    }
+    results.add("read", params, readTimer, content.size());
+  }
+
+  results.print();
+  return 0;
+}
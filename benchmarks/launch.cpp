@@ -0,0 +1,61 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2014-2018 David Medina and Tim Warburton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ */
+
+#include "benchmark.hpp"
+
+// Time from launching an empty kernel until the device is done with it
+int main(const int argc, const char **argv) {
+  occa::device device = bench::getDevice(argc, argv);
+  bench::results results("launch", device);
+
+  occa::kernel emptyKernel = device.buildKernelFromString(
+    "kernel void empty(const int entries) {\n"
+    "  for (int i = 0; i < entries; ++i; tile(16)) {}\n"
+    "}\n",
+    "empty"
+  );
+
+  // Warm up
+  emptyKernel(1);
+  device.finish();
+
+  bench::timer launchTimer(1000);
+  while (launchTimer.next()) {
+    emptyKernel(1);
+    device.finish();
+  }
+  results.add("launch+finish", occa::json(), launchTimer);
+
+  // Back-to-back launches, synchronized once
+  const int batch = 100;
+  bench::timer batchTimer;
+  while (batchTimer.next()) {
+    for (int i = 0; i < batch; ++i) {
+      emptyKernel(1);
+    }
+    device.finish();
+  }
+  results.add("launch-batch", bench::param("launches", batch), batchTimer);
+
+  results.print();
+  return 0;
+}
@@ -0,0 +1,90 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2014-2018 David Medina and Tim Warburton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ */
+
+#include "benchmark.hpp"
+#include "occa/array/linalg.hpp"
+
+// occa::linalg reductions and axpy
+int main(const int argc, const char **argv) {
+  occa::device device = bench::getDevice(argc, argv);
+  bench::results results("linalg", device);
+
+  const int sizes[4] = {
+    1 << 10,
+    1 << 16,
+    1 << 20,
+    1 << 24
+  };
+  const int maxEntries = sizes[3];
+
+  float *host = new float[maxEntries];
+  for (int i = 0; i < maxEntries; ++i) {
+    host[i] = 1.0f / (1 + (i % 64));
+  }
+
+  // Reductions keep their result in a host buffer, volatile keeps them around
+  volatile float result = 0;
+
+  for (int i = 0; i < 4; ++i) {
+    const int entries = sizes[i];
+    const occa::udim_t bytes = entries * sizeof(float);
+    const occa::json params = bench::param("entries", entries);
+
+    // Reductions run over the whole allocation
+    occa::memory xi = device.malloc(bytes, host);
+    occa::memory yi = device.malloc(bytes, host);
+
+    bench::timer sumTimer;
+    while (sumTimer.next()) {
+      result = occa::linalg::sum<float, float>(xi);
+    }
+    results.add("sum", params, sumTimer, bytes);
+
+    bench::timer normTimer;
+    while (normTimer.next()) {
+      result = occa::linalg::l2Norm<float, float>(xi);
+    }
+    results.add("l2Norm", params, normTimer, bytes);
+
+    bench::timer dotTimer;
+    while (dotTimer.next()) {
+      result = occa::linalg::dot<float, float, float>(xi, yi);
+    }
+    results.add("dot", params, dotTimer, 2 * bytes);
+
+    // y is read and written
+    bench::timer axpyTimer;
+    while (axpyTimer.next()) {
+      occa::linalg::axpy<float, float, float>(1e-3f, xi, yi);
+      device.finish();
+    }
+    results.add("axpy", params, axpyTimer, 3 * bytes);
+
+    xi.free();
+    yi.free();
+  }
+
+  delete [] host;
+
+  results.print();
+  return (result < 0);
+}
@@ -0,0 +1,94 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2014-2018 David Medina and Tim Warburton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ */
+
+#include <sstream>
+
+#include "benchmark.hpp"
+#include "occa/parser/parser.hpp"
+#include "occa/tools/env.hpp"
+#include "occa/tools/io.hpp"
+
+// Generates [kernelCount] kernels with nested tiled loops
+std::string largeOklSource(const int kernelCount) {
+  std::stringstream ss;
+  ss << "#define BLOCK 16\n"
+     << "typedef struct { float x, y, z; } float3_t;\n\n";
+  for (int k = 0; k < kernelCount; ++k) {
+    ss << "kernel void kernel" << k << "(const int entries,\n"
+       << "                     const float *a,\n"
+       << "                     const float3_t *b,\n"
+       << "                     float *ab) {\n"
+       << "  for (int block = 0; block < entries; block += BLOCK; outer) {\n"
+       << "    shared float s_a[BLOCK];\n"
+       << "    for (int i = block; i < (block + BLOCK); ++i; inner) {\n"
+       << "      s_a[i - block] = (i < entries) ? a[i] : 0;\n"
+       << "    }\n"
+       << "    for (int i = block; i < (block + BLOCK); ++i; inner) {\n"
+       << "      if (i < entries) {\n"
+       << "        float sum = 0;\n"
+       << "        for (int j = 0; j < BLOCK; ++j) {\n"
+       << "          sum += s_a[j] * (b[i].x + " << k << " * b[i].y - b[i].z);\n"
+       << "        }\n"
+       << "        ab[i] = sum;\n"
+       << "      }\n"
+       << "    }\n"
+       << "  }\n"
+       << "}\n\n";
+  }
+  return ss.str();
+}
+
+// OKL parsing alone, without the backend compiler
+int main(const int argc, const char **argv) {
+  occa::device device = bench::getDevice(argc, argv);
+  bench::results results("parse", device);
+
+  occa::properties props = device.kernelProperties();
+  props["mode"] = device.mode();
+
+  const int kernelCounts[3] = { 1, 50, 500 };
+
+  for (int i = 0; i < 3; ++i) {
+    const int kernelCount = kernelCounts[i];
+
+    std::stringstream ss;
+    ss << occa::env::OCCA_CACHE_DIR << "benchmarks/parse_" << kernelCount << ".okl";
+    const std::string filename = ss.str();
+    const std::string source = largeOklSource(kernelCount);
+    occa::io::write(filename, source);
+
+    occa::json params;
+    params.asObject();
+    params["kernels"] = kernelCount;
+    params["bytes"]   = (int) source.size();
+
+    bench::timer timer(3, 1.0);
+    while (timer.next()) {
+      occa::parser parser;
+      parser.parseFile(filename, props);
+    }
+    results.add("parseFile", params, timer, source.size());
+  }
+
+  results.print();
+  return 0;
+}
@@ -0,0 +1,72 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2014-2018 David Medina and Tim Warburton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ */
+
+#include <vector>
+
+#include "benchmark.hpp"
+#include "occa/uva.hpp"
+
+// Pointer to memory lookups with many live UVA allocations
+int main(const int argc, const char **argv) {
+  occa::device device = bench::getDevice(argc, argv);
+  bench::results results("uva", device);
+
+  const int allocationCounts[3] = { 100, 10000, 100000 };
+  const int lookups = 10000;
+
+  std::vector<char*> ptrs;
+  for (int i = 0; i < 3; ++i) {
+    const int allocations = allocationCounts[i];
+    while ((int) ptrs.size() < allocations) {
+      ptrs.push_back((char*) device.umalloc(64));
+    }
+
+    // Fixed pseudo-random lookups into the middle of allocations
+    std::vector<char*> lookupPtrs(lookups);
+    unsigned int seed = 1;
+    for (int l = 0; l < lookups; ++l) {
+      seed = (1103515245 * seed) + 12345;
+      lookupPtrs[l] = ptrs[seed % allocations] + 32;
+    }
+
+    occa::memory_v *found = NULL;
+    bench::timer timer;
+    while (timer.next()) {
+      for (int l = 0; l < lookups; ++l) {
+        found = occa::uvaToMemory(lookupPtrs[l]);
+      }
+    }
+
+    occa::json params;
+    params.asObject();
+    params["allocations"] = allocations;
+    params["lookups"]     = lookups;
+    results.add("uvaToMemory", params, timer)["found"] = (found != NULL);
+  }
+
+  for (int i = 0; i < (int) ptrs.size(); ++i) {
+    occa::free(ptrs[i]);
+  }
+
+  results.print();
+  return 0;
+}
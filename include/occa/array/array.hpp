@@ -339,6 +339,19 @@ namespace occa {
                   const occa::memory src);
     //==================================
 
+    //---[ mmap(...) ]------------------
+    void mmap(const std::string &filename,
+              const int dim, const udim_t *d,
+              const dim_t offset = 0,
+              const occa::properties &props = occa::properties());
+
+    void mmap(occa::device device_,
+              const std::string &filename,
+              const int dim, const udim_t *d,
+              const dim_t offset = 0,
+              const occa::properties &props = occa::properties());
+    //==================================
+
     //---[ reshape(...) ]---------------
     void reshape(const int dim, const udim_t *d);
 
@@ -772,6 +772,34 @@ namespace occa {
     allocate(src);
   }
 
+  //---[ mmap(...) ]--------------------
+  template <class TM, const int idxType>
+  void array<TM,idxType>::mmap(const std::string &filename,
+                               const int dim_, const udim_t *d,
+                               const dim_t offset,
+                               const occa::properties &props) {
+    mmap(occa::getDevice(),
+         filename,
+         dim_, d,
+         offset,
+         props);
+  }
+
+  template <class TM, const int idxType>
+  void array<TM,idxType>::mmap(occa::device device_,
+                               const std::string &filename,
+                               const int dim_, const udim_t *d,
+                               const dim_t offset,
+                               const occa::properties &props) {
+    device = device_;
+    initSOrder(dim_);
+    reshape(dim_, d);
+
+    ptr_    = (TM*) device.ummap(filename, offset, bytes(), props);
+    memory_ = occa::memory(ptr_);
+    memory_.getMHandle()->setRefs(1);
+  }
+
   //---[ reshape(...) ]-----------------
   template <class TM, const int idxType>
   void array<TM,idxType>::reshape(const int dim_, const udim_t *d) {
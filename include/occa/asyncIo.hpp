@@ -0,0 +1,69 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2014-2018 David Medina and Tim Warburton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ */
+
+#ifndef OCCA_ASYNCIO_HEADER
+#define OCCA_ASYNCIO_HEADER
+
+#include "occa/defines.hpp"
+#include "occa/memory.hpp"
+#include "occa/tools/properties.hpp"
+
+namespace occa {
+  class streamTag;
+
+  //---[ Async I/O ]--------------------
+  // Requests are split into chunks and serviced with pread/pwrite by a
+  //   pool of OCCA_IO_THREADS workers (default 4)
+  //
+  // Properties:
+  //   direct: true            Use O_DIRECT for page-aligned chunks
+  //   chunk-bytes: <bytes>    Chunk size (default 8MB)
+  //
+  // Writes snapshot the memory when called, it can be modified or
+  //   freed right away. Reads into host memory happen in place and it
+  //   should not be touched or freed until the returned tag completes;
+  //   memory in a separate memory space is staged on the host and
+  //   filled when waited on.
+  namespace io {
+    streamTag readAsync(occa::memory mem,
+                        const std::string &filename,
+                        const dim_t bytes = -1,
+                        const dim_t offset = 0,
+                        const occa::properties &props = occa::properties());
+
+    streamTag writeAsync(const std::string &filename,
+                         const occa::memory mem,
+                         const dim_t bytes = -1,
+                         const dim_t offset = 0,
+                         const occa::properties &props = occa::properties());
+
+    bool isAsyncTag(const streamTag &tag);
+    bool isDone(const streamTag &tag);
+
+    // Tags are released after being waited on
+    void waitFor(const streamTag &tag);
+    void finish();
+  }
+  //====================================
+}
+
+#endif
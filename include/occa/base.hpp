@@ -38,6 +38,7 @@
 #include "occa/device.hpp"
 #include "occa/kernel.hpp"
 #include "occa/memory.hpp"
+#include "occa/asyncIo.hpp"
 
 namespace occa {
   //---[ Globals & Flags ]--------------
@@ -122,6 +123,18 @@ namespace occa {
 
   void memcpy(memory dest, memory src,
               const occa::properties &props);
+
+  void memcpy(memoryView dest, const void *src,
+              const dim_t bytes = -1,
+              const occa::properties &props = properties());
+
+  void memcpy(void *dest, memoryView src,
+              const dim_t bytes = -1,
+              const occa::properties &props = properties());
+
+  void memcpy(memoryView dest, memoryView src,
+              const dim_t bytes = -1,
+              const occa::properties &props = properties());
   //====================================
 
   //---[ Free Functions ]---------------
@@ -58,6 +58,10 @@ OCCA_LFUNC void OCCA_RFUNC occaMemorySyncToDevice(occaMemory memory,
 OCCA_LFUNC void OCCA_RFUNC occaMemorySyncToHost(occaMemory memory,
                                                 const occaDim_t bytes,
                                                 const occaDim_t offset);
+
+OCCA_LFUNC void OCCA_RFUNC occaMemoryMarkDirty(occaMemory memory,
+                                               const occaDim_t bytes,
+                                               const occaDim_t offset);
 //======================================
 
 OCCA_LFUNC void OCCA_RFUNC occaMemcpy(void *dest,
@@ -169,6 +169,266 @@ using namespace occa;
 
 
 //---[ Atomics ]----------------------------------
+// Atomics are relaxed read-modify-writes, matching the CUDA and OpenCL ones.
+//   Integral types use the fetch-and-op builtins, other types (float, double)
+//   use compare-and-swap loops
+#if defined(__GNUC__) || defined(__clang__)
+#  define OCCA_ATOMIC_BUILTINS 1
+#else
+#  define OCCA_ATOMIC_BUILTINS 0
+#endif
+
+namespace occa {
+  namespace cpu {
+    template <class TM>
+    struct atomicIsIntegral {
+      static const bool value = false;
+    };
+
+#define OCCA_ATOMIC_INTEGRAL(TYPE)              \
+    template <>                                 \
+    struct atomicIsIntegral<TYPE> {             \
+      static const bool value = true;           \
+    }
+
+    OCCA_ATOMIC_INTEGRAL(char);
+    OCCA_ATOMIC_INTEGRAL(signed char);
+    OCCA_ATOMIC_INTEGRAL(unsigned char);
+    OCCA_ATOMIC_INTEGRAL(short);
+    OCCA_ATOMIC_INTEGRAL(unsigned short);
+    OCCA_ATOMIC_INTEGRAL(int);
+    OCCA_ATOMIC_INTEGRAL(unsigned int);
+    OCCA_ATOMIC_INTEGRAL(long);
+    OCCA_ATOMIC_INTEGRAL(unsigned long);
+    OCCA_ATOMIC_INTEGRAL(long long);
+    OCCA_ATOMIC_INTEGRAL(unsigned long long);
+
+#undef OCCA_ATOMIC_INTEGRAL
+
+#if OCCA_ATOMIC_BUILTINS
+    template <class TM>
+    inline TM atomicLoad(TM *ptr) {
+      TM value;
+      __atomic_load(ptr, &value, __ATOMIC_RELAXED);
+      return value;
+    }
+
+    // On failure, [expected] is updated with the current value
+    template <class TM>
+    inline bool atomicCAS(TM *ptr, TM &expected, TM desired) {
+      return __atomic_compare_exchange(ptr, &expected, &desired,
+                                       false,
+                                       __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+    }
+
+    // Can fail spuriously, only for use in retry loops
+    template <class TM>
+    inline bool atomicWeakCAS(TM *ptr, TM &expected, TM desired) {
+      return __atomic_compare_exchange(ptr, &expected, &desired,
+                                       true,
+                                       __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+    }
+
+    template <class TM>
+    inline TM atomicSwap(TM *ptr, TM update) {
+      TM old;
+      __atomic_exchange(ptr, &update, &old, __ATOMIC_RELAXED);
+      return old;
+    }
+
+    template <class TM, bool isIntegral = atomicIsIntegral<TM>::value>
+    struct atomicOps {
+      static inline TM add(TM *ptr, const TM &update) {
+        TM old = atomicLoad(ptr);
+        while (!atomicWeakCAS(ptr, old, (TM) (old + update))) {}
+        return old;
+      }
+
+      static inline TM sub(TM *ptr, const TM &update) {
+        TM old = atomicLoad(ptr);
+        while (!atomicWeakCAS(ptr, old, (TM) (old - update))) {}
+        return old;
+      }
+    };
+
+    template <class TM>
+    struct atomicOps<TM, true> {
+      static inline TM add(TM *ptr, const TM &update) {
+        return __atomic_fetch_add(ptr, update, __ATOMIC_RELAXED);
+      }
+
+      static inline TM sub(TM *ptr, const TM &update) {
+        return __atomic_fetch_sub(ptr, update, __ATOMIC_RELAXED);
+      }
+
+      static inline TM bitAnd(TM *ptr, const TM &update) {
+        return __atomic_fetch_and(ptr, update, __ATOMIC_RELAXED);
+      }
+
+      static inline TM bitOr(TM *ptr, const TM &update) {
+        return __atomic_fetch_or(ptr, update, __ATOMIC_RELAXED);
+      }
+
+      static inline TM bitXor(TM *ptr, const TM &update) {
+        return __atomic_fetch_xor(ptr, update, __ATOMIC_RELAXED);
+      }
+    };
+#else
+    // Fallback for compilers without the __atomic builtins
+    template <class TM>
+    inline TM atomicLoad(TM *ptr) {
+      return *ptr;
+    }
+
+    template <class TM>
+    inline bool atomicCAS(TM *ptr, TM &expected, TM desired) {
+      bool swapped;
+#pragma omp critical
+      {
+        swapped = (*ptr == expected);
+        if (swapped) {
+          *ptr = desired;
+        } else {
+          expected = *ptr;
+        }
+      }
+      return swapped;
+    }
+
+    template <class TM>
+    inline bool atomicWeakCAS(TM *ptr, TM &expected, TM desired) {
+      return atomicCAS(ptr, expected, desired);
+    }
+
+    template <class TM>
+    inline TM atomicSwap(TM *ptr, TM update) {
+      TM old;
+#pragma omp critical
+      {
+        old  = *ptr;
+        *ptr = update;
+      }
+      return old;
+    }
+
+    template <class TM, bool isIntegral = atomicIsIntegral<TM>::value>
+    struct atomicOps {
+#define OCCA_ATOMIC_CRITICAL_OP(NAME, OP)                       \
+      static inline TM NAME(TM *ptr, const TM &update) {        \
+        TM old;                                                 \
+        OCCA_PRAGMA("omp critical")                             \
+        {                                                       \
+          old   = *ptr;                                         \
+          *ptr OP update;                                       \
+        }                                                       \
+        return old;                                             \
+      }
+
+      OCCA_ATOMIC_CRITICAL_OP(add   , +=)
+      OCCA_ATOMIC_CRITICAL_OP(sub   , -=)
+      OCCA_ATOMIC_CRITICAL_OP(bitAnd, &=)
+      OCCA_ATOMIC_CRITICAL_OP(bitOr , |=)
+      OCCA_ATOMIC_CRITICAL_OP(bitXor, ^=)
+
+#undef OCCA_ATOMIC_CRITICAL_OP
+    };
+#endif
+
+    // Keeps arguments out of template deduction, they convert to [TM]
+    template <class TM>
+    struct atomicArg {
+      typedef TM type;
+    };
+
+    template <class TM>
+    inline TM atomicMin(TM *ptr, const TM &update) {
+      TM old = atomicLoad(ptr);
+      while ((update < old) && !atomicWeakCAS(ptr, old, update)) {}
+      return old;
+    }
+
+    template <class TM>
+    inline TM atomicMax(TM *ptr, const TM &update) {
+      TM old = atomicLoad(ptr);
+      while ((old < update) && !atomicWeakCAS(ptr, old, update)) {}
+      return old;
+    }
+  }
+}
+
+template <class TM>
+inline TM occaAtomicAdd(TM *ptr, const TM &update) {
+  return occa::cpu::atomicOps<TM>::add(ptr, update);
+}
+
+template <class TM>
+inline TM occaAtomicSub(TM *ptr, const TM &update) {
+  return occa::cpu::atomicOps<TM>::sub(ptr, update);
+}
+
+template <class TM>
+inline TM occaAtomicSwap(TM *ptr, const TM &update) {
+  return occa::cpu::atomicSwap(ptr, update);
+}
+
+template <class TM>
+inline TM occaAtomicInc(TM *ptr) {
+  return occa::cpu::atomicOps<TM>::add(ptr, (TM) 1);
+}
+
+template <class TM>
+inline TM occaAtomicDec(TM *ptr) {
+  return occa::cpu::atomicOps<TM>::sub(ptr, (TM) 1);
+}
+
+// Forms taking an update like the GPU modes, still stepping by one
+template <class TM>
+inline TM occaAtomicInc(TM *ptr,
+                        const typename occa::cpu::atomicArg<TM>::type &update) {
+  return occa::cpu::atomicOps<TM>::add(ptr, (TM) 1);
+}
+
+template <class TM>
+inline TM occaAtomicDec(TM *ptr,
+                        const typename occa::cpu::atomicArg<TM>::type &update) {
+  return occa::cpu::atomicOps<TM>::sub(ptr, (TM) 1);
+}
+
+template <class TM>
+inline TM occaAtomicMin(TM *ptr, const TM &update) {
+  return occa::cpu::atomicMin(ptr, update);
+}
+
+template <class TM>
+inline TM occaAtomicMax(TM *ptr, const TM &update) {
+  return occa::cpu::atomicMax(ptr, update);
+}
+
+template <class TM>
+inline TM occaAtomicAnd(TM *ptr, const TM &update) {
+  return occa::cpu::atomicOps<TM>::bitAnd(ptr, update);
+}
+
+template <class TM>
+inline TM occaAtomicOr(TM *ptr, const TM &update) {
+  return occa::cpu::atomicOps<TM>::bitOr(ptr, update);
+}
+
+template <class TM>
+inline TM occaAtomicXor(TM *ptr, const TM &update) {
+  return occa::cpu::atomicOps<TM>::bitXor(ptr, update);
+}
+
+// Stores [update] if [*ptr == comp], returns the old value
+template <class TM>
+inline TM occaAtomicCAS(TM *ptr,
+                        const typename occa::cpu::atomicArg<TM>::type &comp,
+                        const typename occa::cpu::atomicArg<TM>::type &update) {
+  TM old = comp;
+  occa::cpu::atomicCAS(ptr, old, update);
+  return old;
+}
+
 #define occaAtomicAdd64  occaAtomicAdd
 #define occaAtomicSub64  occaAtomicSub
 #define occaAtomicSwap64 occaAtomicSwap
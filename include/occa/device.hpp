@@ -29,6 +29,8 @@
 #include "occa/defines.hpp"
 #include "occa/uva.hpp"
 #include "occa/kernel.hpp"
+#include "occa/memoryPool.hpp"
+#include "occa/memoryStats.hpp"
 #include "occa/tools/gc.hpp"
 #include "occa/parser/tools.hpp"
 
@@ -46,6 +48,10 @@ namespace occa {
   typedef cachedKernelMap::iterator       cachedKernelMapIterator;
   typedef cachedKernelMap::const_iterator cCachedKernelMapIterator;
 
+  typedef std::map<hash_t, memoryPool*> memoryPoolMap;
+  typedef memoryPoolMap::iterator       memoryPoolMapIterator;
+  typedef memoryPoolMap::const_iterator cMemoryPoolMapIterator;
+
   //---[ device_v ]---------------------
   class device_v : public withRefs {
   public:
@@ -58,9 +64,14 @@ namespace occa {
     stream_t currentStream;
     std::vector<stream_t> streams;
 
-    udim_t bytesAllocated;
+    memoryTracker allocations;
+
+    // One pool per distinct set of allocation properties, blocks
+    //   inherit the properties of the chunk they come from
+    memoryPoolMap pools;
 
     cachedKernelMap cachedKernels;
+    kernelStatsRegistry kernelStats;
 
     device_v(const occa::properties &properties_);
 
@@ -83,6 +94,8 @@ namespace occa {
     virtual void waitFor(streamTag tag) const = 0;
     virtual double timeBetween(const streamTag &startTag,
                                const streamTag &endTag) const = 0;
+    // Releases backend handles held by [tag] (default is a no-op)
+    virtual void freeStreamTag(const streamTag &tag) const;
 
     virtual stream_t wrapStream(void *handle_,
                                 const occa::properties &props) const = 0;
@@ -110,6 +123,14 @@ namespace occa {
     virtual kernel_v* buildKernelFromBinary(const std::string &filename,
                                             const std::string &kernelName,
                                             const occa::properties &props) = 0;
+
+    // Launch kernels wrap their nested-kernel calls with these so
+    //   backends can batch the calls (default is a no-op)
+    // cancelNestedLaunches() replaces finishNestedLaunches() when the
+    //   launch kernel throws, dropping the batched calls
+    virtual void startNestedLaunches();
+    virtual void finishNestedLaunches();
+    virtual void cancelNestedLaunches();
     //  |===============================
 
     //  |---[ Memory ]------------------
@@ -117,7 +138,17 @@ namespace occa {
                              const void* src,
                              const occa::properties &props) = 0;
 
+    // Default reads the file in chunks into a new allocation
+    virtual memory_v* mmap(const std::string &filename,
+                           const udim_t offset,
+                           const udim_t bytes,
+                           const occa::properties &props);
+
     virtual udim_t memorySize() const = 0;
+
+    memoryPool& getMemoryPool(const occa::properties &props);
+    memoryPool* findMemoryPool(memory_v *mem);
+    void freeMemoryPools();
     //  |===============================
     //==================================
   };
@@ -175,6 +206,15 @@ namespace occa {
     udim_t memorySize() const;
     udim_t memoryAllocated() const;
 
+    memoryStats getMemoryStats() const;
+    void resetMemoryPeaks();
+    std::string liveMemoryReport() const;
+
+    memoryPoolStats getMemoryPoolStats() const;
+    void trimMemoryPool();
+
+    const kernelLaunchStatsMap& kernelStats();
+
     void finish();
 
     bool hasSeparateMemorySpace();
@@ -242,6 +282,20 @@ namespace occa {
 
     void* umalloc(const dim_t bytes,
                   const occa::properties &props);
+
+    // Maps [bytes] of [filename] starting at [offset]
+    //   bytes = -1 maps the rest of the file
+    //   props.mapping: 'private' (default), 'readonly' or 'shared'
+    //   Modes without host memory copy the file and only support 'private'
+    occa::memory mmap(const std::string &filename,
+                      const dim_t offset = 0,
+                      const dim_t bytes = -1,
+                      const occa::properties &props = occa::properties());
+
+    void* ummap(const std::string &filename,
+                const dim_t offset = 0,
+                const dim_t bytes = -1,
+                const occa::properties &props = occa::properties());
     //  |===============================
   };
 
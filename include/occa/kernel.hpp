@@ -27,6 +27,7 @@
 #include <stdint.h>
 
 #include "occa/defines.hpp"
+#include "occa/kernelStats.hpp"
 #include "occa/tools/gc.hpp"
 #include "occa/tools/properties.hpp"
 #include "occa/parser/types.hpp"
@@ -172,6 +173,9 @@ namespace occa {
 
     kernelMetadata metadata;
 
+    // Cached entry in the device's kernel stats, set on the first launch
+    kernelLaunchStats *launchStats;
+
     kernel_v(const occa::properties &properties_);
 
     // This should only be called in the very first reference
@@ -214,6 +218,10 @@ namespace occa {
     virtual dim maxInnerDims() const = 0;
 
     virtual void runFromArguments(const int kArgc, const kernelArg *kArgs) const = 0;
+
+    // True if runFromArguments() only queues the launch to run later
+    //   with the rest of its launcher's nested kernels
+    virtual bool isBatched() const;
     //==================================
   };
   //====================================
@@ -264,6 +272,8 @@ namespace occa {
     void runFromArguments() const;
     void clearArgumentList();
 
+    kernelLaunchStats stats();
+
 #include "occa/operators/declarations.hpp"
 
     void free();
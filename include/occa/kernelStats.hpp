@@ -0,0 +1,151 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2014-2018 David Medina and Tim Warburton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ */
+
+#ifndef OCCA_KERNELSTATS_HEADER
+#define OCCA_KERNELSTATS_HEADER
+
+#include <map>
+#include <vector>
+
+#include "occa/defines.hpp"
+#include "occa/types.hpp"
+#include "occa/tools/exitReport.hpp"
+#include "occa/tools/perfCounters.hpp"
+
+namespace occa {
+  class kernel_v;
+  class device_v;
+  class streamTag;
+
+  //---[ kernelLaunchStats ]------------
+  class kernelLaunchStats {
+  public:
+    static const int recentTimeCount = 1024;
+
+    std::string name;
+    std::string hash;
+
+    udim_t launches;
+    // Launches run in their launcher's batch (OpenMP nested kernels),
+    //   their time and counters are part of the launcher's
+    udim_t batchedLaunches;
+    // Bytes of memory arguments passed to the launches
+    udim_t argumentBytes;
+
+    // Times (seconds) come from the device's stream tags on sampled launches
+    udim_t timedLaunches;
+    double totalTime, minTime, maxTime;
+    std::vector<double> recentTimes;
+
+    // Hardware counters summed over launches, see [perf-counters]
+    udim_t countedLaunches;
+    perfCounterValues counters;
+
+    kernelLaunchStats();
+
+    void addTime(const double time);
+
+    double meanTime() const;
+    // Taken over the last [recentTimeCount] timed launches
+    double p99Time() const;
+
+    std::string toString() const;
+  };
+
+  typedef std::map<std::string, kernelLaunchStats> kernelLaunchStatsMap;
+
+  // State carried from startLaunch() to finishLaunch()
+  class kernelLaunchTag {
+  public:
+    bool isTimed;
+    bool isCounted;
+    perfCounterValues startCounters;
+
+    kernelLaunchTag();
+  };
+  //====================================
+
+  //---[ kernelStatsRegistry ]----------
+  // Launch statistics for a device's kernels, keyed by kernel hash and name
+  //
+  // One in [kernel-stats-sampling] launches (default 16, 0 to disable)
+  //   is timed. Timings are read once the device is done with them:
+  //   in finish(), when stats are requested, or once enough pile up
+  //
+  // CPU modes can also read hardware counters around each launch
+  //   with [perf-counters: true] (Linux only)
+  //
+  // Stats are printed to stderr when their device is freed or the
+  //   program exits if OCCA_KERNEL_REPORT is set
+  class kernelStatsRegistry : public exitReporter {
+  private:
+    class pendingLaunch;
+
+    device_v *dHandle;
+    int sampling;
+
+    kernelLaunchStatsMap stats;
+    std::vector<pendingLaunch*> pendingLaunches;
+
+    perfCounters *counters;
+
+    kernelStatsRegistry(const kernelStatsRegistry &r);
+    kernelStatsRegistry& operator = (const kernelStatsRegistry &r);
+
+  public:
+    kernelStatsRegistry();
+    ~kernelStatsRegistry();
+
+    void setup(device_v *dHandle_,
+               const int sampling_);
+
+    // Returns false if the launch is neither timed nor counted,
+    //   in which case finishLaunch() isn't needed
+    // Batched launches are never timed or counted
+    bool startLaunch(kernel_v *kernel,
+                     const udim_t argumentBytes,
+                     const bool isBatched,
+                     kernelLaunchTag &tag,
+                     streamTag &startTag);
+    void finishLaunch(kernel_v *kernel,
+                      const kernelLaunchTag &tag,
+                      const streamTag &startTag);
+
+    // Returns false if no counter is available
+    bool enablePerfCounters();
+
+    // Reads timings of finished launches, waiting on the device if needed
+    void resolvePending();
+
+    const kernelLaunchStatsMap& getStats();
+    kernelLaunchStats getStats(kernel_v *kernel);
+
+    std::string toString() const;
+    virtual void printExitReport();
+
+  private:
+    kernelLaunchStats& getKernelStats(kernel_v *kernel);
+  };
+  //====================================
+}
+
+#endif
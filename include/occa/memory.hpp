@@ -24,6 +24,7 @@
 #define OCCA_MEMORY_HEADER
 
 #include <iostream>
+#include <vector>
 
 #include "occa/defines.hpp"
 #include "occa/tools/gc.hpp"
@@ -34,6 +35,7 @@ namespace occa {
   class memory_v; class memory;
   class device_v; class device;
   class kernelArg;
+  class memoryView;
 
 
   typedef std::map<hash_t,occa::memory>   hashedMemoryMap;
@@ -45,8 +47,33 @@ namespace occa {
     static const int isManaged    = (1 << 0);
     static const int inDevice     = (1 << 1);
     static const int isStale      = (1 << 2);
+    static const int tracksDirty  = (1 << 3);
   }
 
+  //---[ dirtyRanges ]------------------
+  // Sorted, disjoint [start, end) byte ranges of a host mirror
+  //   written since it was last synced
+  class dirtyRanges {
+  public:
+    typedef std::pair<udim_t, udim_t> range;
+    typedef std::vector<range>        rangeVector;
+
+    rangeVector ranges;
+
+    bool isEmpty() const;
+    udim_t bytes() const;
+
+    void clear();
+
+    // Merges with overlapping or adjacent ranges
+    void add(const udim_t start, const udim_t end);
+
+    // Removes [start, end), returning the dirty pieces inside it
+    void remove(const udim_t start, const udim_t end,
+                rangeVector &removed);
+  };
+  //====================================
+
   //---[ memory_v ]---------------------
   class memory_v : public withRefs {
   public:
@@ -59,11 +86,19 @@ namespace occa {
 
     udim_t size;
 
+    // Position in [uvaStaleMemory], -1 if not stale
+    int staleIndex;
+    dirtyRanges dirty;
+
     memory_v(const occa::properties &properties_);
 
     bool isManaged() const;
     bool inDevice() const;
     bool isStale() const;
+    bool tracksDirty() const;
+
+    // Copies dirty host ranges inside [start, end) to the device
+    void syncDirtyToDevice(const udim_t start, const udim_t end);
 
     //---[ Virtual Methods ]------------
     virtual ~memory_v() = 0;
@@ -72,6 +107,10 @@ namespace occa {
 
     virtual kernelArg makeKernelArg() const = 0;
 
+    // Kernel argument [offset] bytes into the memory, used by memoryView
+    //   to avoid allocating a new memory_v through addOffset
+    virtual kernelArg makeOffsetKernelArg(const udim_t offset) const = 0;
+
     virtual memory_v* addOffset(const dim_t offset, bool &needsFree) = 0;
 
     virtual void copyTo(void *dest,
@@ -178,6 +217,12 @@ namespace occa {
     void syncToDevice(const dim_t bytes, const dim_t offset);
     void syncToHost(const dim_t bytes, const dim_t offset);
 
+    // Records host writes to the UVA pointer so syncs only copy
+    //   the modified ranges
+    void markDirty(const dim_t offset = 0,
+                   const dim_t bytes = -1);
+    udim_t dirtyBytes() const;
+
     bool uvaIsStale() const;
     void uvaMarkStale();
     void uvaMarkFresh();
@@ -189,6 +234,9 @@ namespace occa {
     occa::memory operator + (const dim_t offset) const;
     occa::memory& operator += (const dim_t offset);
 
+    memoryView view(const dim_t offset = 0,
+                    const dim_t bytes = -1) const;
+
     void copyFrom(const void *src,
                   const dim_t bytes = -1,
                   const dim_t offset = 0,
@@ -229,6 +277,69 @@ namespace occa {
   };
   //====================================
 
+  //---[ memoryView ]-------------------
+  // A (memory, offset, size) window passed by value, unlike memory + offset
+  //   it doesn't allocate a new memory_v
+  class memoryView {
+  private:
+    occa::memory mem;
+    udim_t offset_;
+    udim_t size_;
+
+  public:
+    memoryView();
+    memoryView(const occa::memory &mem_,
+               const dim_t offset = 0,
+               const dim_t bytes = -1);
+
+    bool isInitialized() const;
+
+    occa::memory getMemory() const;
+    memory_v* getMHandle() const;
+    device_v* getDHandle() const;
+
+    occa::device getDevice() const;
+
+    void* ptr();
+    const void* ptr() const;
+
+    udim_t offset() const;
+    udim_t size() const;
+
+    template <class TM>
+    udim_t size() const {
+      return (size_ / sizeof(TM));
+    }
+
+    operator kernelArg() const;
+
+    memoryView operator + (const dim_t offset) const;
+    memoryView& operator += (const dim_t offset);
+
+    void copyFrom(const void *src,
+                  const dim_t bytes = -1,
+                  const dim_t offset = 0,
+                  const occa::properties &props = occa::properties());
+
+    void copyFrom(const memoryView src,
+                  const dim_t bytes = -1,
+                  const dim_t destOffset = 0,
+                  const dim_t srcOffset = 0,
+                  const occa::properties &props = occa::properties());
+
+    void copyTo(void *dest,
+                const dim_t bytes = -1,
+                const dim_t offset = 0,
+                const occa::properties &props = occa::properties()) const;
+
+    void copyTo(const memoryView dest,
+                const dim_t bytes = -1,
+                const dim_t destOffset = 0,
+                const dim_t srcOffset = 0,
+                const occa::properties &props = occa::properties()) const;
+  };
+  //====================================
+
   namespace cpu {
     occa::memory wrapMemory(void *ptr, const udim_t bytes);
   }
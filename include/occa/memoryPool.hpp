@@ -0,0 +1,128 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2014-2018 David Medina and Tim Warburton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ */
+
+#ifndef OCCA_MEMORYPOOL_HEADER
+#define OCCA_MEMORYPOOL_HEADER
+
+#include <map>
+#include <vector>
+
+#include "occa/defines.hpp"
+#include "occa/tools/properties.hpp"
+
+namespace occa {
+  class memory_v;
+  class device_v;
+
+  //---[ memoryPoolStats ]--------------
+  class memoryPoolStats {
+  public:
+    udim_t reservedBytes;
+    udim_t peakReservedBytes;
+    udim_t usedBytes;
+    udim_t peakUsedBytes;
+
+    udim_t allocations;
+    udim_t reusedAllocations;
+    udim_t backendAllocations;
+    udim_t backendFrees;
+
+    memoryPoolStats();
+
+    // Peaks are summed, giving an upper bound across pools
+    memoryPoolStats& operator += (const memoryPoolStats &other);
+
+    std::string toString() const;
+  };
+  //====================================
+
+  //---[ memoryPool ]-------------------
+  // Caches backend allocations in chunks and hands out blocks through
+  //   memory_v::addOffset, letting any backend share the same pool
+  class memoryPool {
+  private:
+    class chunk;
+
+    class block {
+    public:
+      chunk *owner;
+      udim_t offset, bytes;
+      bool isFree, handleNeedsFree;
+      block *prev, *next;
+
+      block(chunk *owner_,
+            const udim_t offset_,
+            const udim_t bytes_);
+    };
+
+    class chunk {
+    public:
+      memory_v *mHandle;
+      udim_t bytes;
+      block *firstBlock;
+    };
+
+    typedef std::multimap<udim_t, block*> freeBlockMap;
+    typedef std::map<memory_v*, block*>   usedBlockMap;
+
+    device_v *dHandle;
+    udim_t chunkBytes;
+
+    std::vector<chunk*> chunks;
+    freeBlockMap freeBlocks;
+    usedBlockMap usedBlocks;
+
+    memoryPoolStats stats;
+
+  public:
+    static const udim_t alignment = 256;
+
+    memoryPool(device_v *dHandle_,
+               const occa::properties &props);
+    ~memoryPool();
+
+    memory_v* malloc(const udim_t bytes,
+                     const void *src,
+                     const occa::properties &props);
+
+    bool owns(memory_v *mem) const;
+    void release(memory_v *mem, const bool freeBlock);
+
+    // Returns unused chunks to the backend
+    void trim();
+
+    const memoryPoolStats& getStats() const;
+
+  private:
+    block* newChunk(const udim_t bytes,
+                    const occa::properties &props);
+    void freeChunk(chunk *c);
+
+    void addFreeBlock(block *b);
+    void removeFreeBlock(block *b);
+    void splitBlock(block *b, const udim_t bytes);
+    block* mergeBlocks(block *left, block *right);
+  };
+  //====================================
+}
+
+#endif
@@ -0,0 +1,108 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2014-2018 David Medina and Tim Warburton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ */
+
+#ifndef OCCA_MEMORYSTATS_HEADER
+#define OCCA_MEMORYSTATS_HEADER
+
+#include <map>
+#include <vector>
+
+#include "occa/defines.hpp"
+#include "occa/types.hpp"
+#include "occa/tools/exitReport.hpp"
+
+namespace occa {
+  class memory_v;
+
+  //---[ memoryStats ]------------------
+  class memoryTagStats {
+  public:
+    udim_t bytes;
+    udim_t peakBytes;
+    udim_t allocations;
+
+    memoryTagStats();
+  };
+
+  typedef std::map<std::string, memoryTagStats> memoryTagStatsMap;
+
+  class memoryStats {
+  public:
+    static const int histogramBins = 48;
+
+    udim_t bytes;
+    udim_t peakBytes;
+    udim_t allocations;
+    udim_t frees;
+
+    // Allocations of [2^i, 2^(i+1)) bytes, the last bin takes the rest
+    std::vector<udim_t> sizeHistogram;
+
+    // Grouped by [memory/tag], untagged memory isn't listed
+    memoryTagStatsMap tags;
+
+    memoryStats();
+
+    std::string toString() const;
+  };
+  //====================================
+
+  //---[ memoryTracker ]----------------
+  // Keeps a device's live allocations for its memoryStats
+  //
+  // Live allocations are printed to stderr when their device is freed
+  //   or the program exits if OCCA_MEMORY_REPORT is set
+  class memoryTracker : public exitReporter {
+  private:
+    class allocation {
+    public:
+      udim_t bytes;
+      std::string tag;
+    };
+
+    typedef std::map<memory_v*, allocation> allocationMap;
+
+    std::string name;
+    memoryStats stats;
+    allocationMap liveAllocations;
+
+  public:
+    memoryTracker();
+    ~memoryTracker();
+
+    void setName(const std::string &name_);
+
+    void add(memory_v *mem,
+             const udim_t bytes,
+             const std::string &tag);
+    void remove(memory_v *mem);
+
+    const memoryStats& getStats() const;
+    void resetPeaks();
+
+    std::string liveReport() const;
+    virtual void printExitReport();
+  };
+  //====================================
+}
+
+#endif
@@ -65,6 +65,7 @@ namespace occa {
       virtual void waitFor(streamTag tag) const;
       virtual double timeBetween(const streamTag &startTag,
                                  const streamTag &endTag) const;
+      virtual void freeStreamTag(const streamTag &tag) const;
 
       virtual stream_t wrapStream(void *handle_,
                                   const occa::properties &props) const;
@@ -50,6 +50,7 @@ namespace occa {
       ~memory();
 
       kernelArg makeKernelArg() const;
+      kernelArg makeOffsetKernelArg(const udim_t offset) const;
 
       memory_v* addOffset(const dim_t offset, bool &needsFree);
 
@@ -0,0 +1,53 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2014-2018 David Medina and Tim Warburton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ */
+
+#ifndef OCCA_EMULATED_DEVICE_HEADER
+#define OCCA_EMULATED_DEVICE_HEADER
+
+#include "occa/defines.hpp"
+#include "occa/modes/serial/device.hpp"
+
+namespace occa {
+  namespace emulated {
+    // Runs Serial kernels on memory kept apart from the host, modeling
+    //   a discrete device to test UVA syncs and transfer overlap
+    //
+    // Transfers between the host and device memory are throttled:
+    //   bandwidth: GB/s (default 16)
+    //   latency:   Microseconds per transfer (default 10)
+    class device : public serial::device {
+    private:
+      double bandwidth;
+      double latency;
+
+    public:
+      device(const occa::properties &properties_);
+
+      virtual bool hasSeparateMemorySpace() const;
+
+      virtual void finishTransfer(const udim_t bytes,
+                                  const double startTime) const;
+    };
+  }
+}
+
+#endif
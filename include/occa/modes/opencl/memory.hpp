@@ -26,6 +26,8 @@
 #  ifndef OCCA_OPENCL_MEMORY_HEADER
 #  define OCCA_OPENCL_MEMORY_HEADER
 
+#include <map>
+
 #include "occa/memory.hpp"
 #include "occa/modes/opencl/headers.hpp"
 
@@ -45,11 +47,17 @@ namespace occa {
       cl_mem clMem;
       void *mappedPtr;
 
+      // Sub-buffers created for offset kernel arguments, indexed by offset
+      mutable std::map<udim_t, cl_mem> subBuffers;
+
+      void freeSubBuffers();
+
     public:
       memory(const occa::properties &properties_ = occa::properties());
       ~memory();
 
       kernelArg makeKernelArg() const;
+      kernelArg makeOffsetKernelArg(const udim_t offset) const;
 
       memory_v* addOffset(const dim_t offset, bool &needsFree);
 
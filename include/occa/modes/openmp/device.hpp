@@ -27,9 +27,41 @@
 #  define OCCA_OPENMP_DEVICE_HEADER
 
 #include "occa/modes/serial/device.hpp"
+#include "occa/modes/serial/kernel.hpp"
 
 namespace occa {
   namespace openmp {
+    class kernel;
+
+    //---[ Nested Launch ]--------------
+    class addressRange {
+    public:
+      const char *start, *end;
+      bool isWritten;
+
+      addressRange(const char *start_,
+                   const char *end_,
+                   const bool isWritten_);
+
+      bool conflictsWith(const addressRange &r) const;
+    };
+
+    class nestedLaunch {
+    public:
+      handleFunction_t handle;
+      bool passesKernelInfo;
+      serial::kernelInfoArg_t info;
+      std::vector<kernelArg> args;
+      bool needsBarrier;
+      int threads;
+      std::string procBind;
+
+      nestedLaunch();
+
+      int getArgs(void **vArgs);
+    };
+    //==================================
+
     class device : public serial::device {
     private:
       // Make sure we don't warn everytime we switch from [OpenMP] -> [Serial]
@@ -37,6 +69,19 @@ namespace occa {
       std::string lastCompiler;
       std::string lastCompilerOpenMPFlag;
 
+      // Nested kernels called from one launch kernel are replayed
+      //   inside a single parallel region
+      int nestedLaunchDepth;
+      std::vector<nestedLaunch> nestedLaunches;
+      std::vector<addressRange> unsyncedRanges;
+
+      // Copies at least this large are split across threads
+      udim_t parallelCopyBytes;
+
+      void flushNestedLaunches();
+      void runNestedLaunches(std::vector<void*> &vArgs,
+                             const std::vector<int> &argc);
+
     public:
       device(const occa::properties &properties_);
 
@@ -44,6 +89,25 @@ namespace occa {
                                     const std::string &kernelName,
                                     const hash_t kernelHash,
                                     const occa::properties &props);
+
+      virtual void startNestedLaunches();
+      virtual void finishNestedLaunches();
+      virtual void cancelNestedLaunches();
+
+      virtual void firstTouch(char *ptr,
+                              const void *src,
+                              const udim_t bytes);
+
+      virtual void bulkCopy(void *dest,
+                            const void *src,
+                            const udim_t bytes,
+                            const bool nonTemporal) const;
+
+      bool isBatchingLaunches() const;
+      void addNestedLaunch(const openmp::kernel &kernel,
+                           handleFunction_t handle,
+                           const int kArgc,
+                           const kernelArg *kArgs);
     };
   }
 }
@@ -33,6 +33,15 @@ namespace occa {
     class kernel : public serial::kernel {
     public:
       kernel(const occa::properties &properties_);
+
+      static std::string forClauses(const occa::properties &props);
+      static std::string parallelClauses(const occa::properties &props);
+
+      static int getThreads(const occa::properties &props);
+      static std::string getProcBind(const occa::properties &props);
+
+      void runFromArguments(const int kArgc, const kernelArg *kArgs) const;
+      bool isBatched() const;
     };
   }
 }
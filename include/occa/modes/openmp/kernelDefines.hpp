@@ -37,191 +37,6 @@
 //================================================
 
 
-//---[ Atomics ]----------------------------------
-template <class TM>
-TM occaAtomicAdd(TM *ptr, const TM &update) {
-  TM old;
-
-#ifdef OPENMP_3_1
-#  pragma omp atomic capture
-#else
-#  pragma omp critical
-#endif
-  {
-    old   = *ptr;
-    *ptr += update;
-  }
-
-  return old;
-}
-
-template <class TM>
-TM occaAtomicSub(TM *ptr, const TM &update) {
-  TM old;
-
-#ifdef OPENMP_3_1
-#  pragma omp atomic capture
-#else
-#  pragma omp critical
-#endif
-  {
-    old   = *ptr;
-    *ptr -= update;
-  }
-
-  return old;
-}
-
-template <class TM>
-TM occaAtomicSwap(TM *ptr, const TM &update) {
-  TM old;
-
-#ifdef OPENMP_3_1
-#  pragma omp atomic capture
-#else
-#  pragma omp critical
-#endif
-  {
-    old  = *ptr;
-    *ptr = update;
-  }
-
-  return old;
-}
-
-template <class TM>
-TM occaAtomicInc(TM *ptr) {
-  TM old;
-
-#ifdef OPENMP_3_1
-#  pragma omp atomic capture
-#else
-#  pragma omp critical
-#endif
-  {
-    old = *ptr;
-  ++(*ptr);
-  }
-
-  return old;
-}
-
-template <class TM>
-TM occaAtomicDec(TM *ptr, const TM &update) {
-  TM old;
-
-#ifdef OPENMP_3_1
-#  pragma omp atomic capture
-#else
-#  pragma omp critical
-#endif
-  {
-    old = *ptr;
-    --(*ptr);
-  }
-
-  return old;
-}
-
-template <class TM>
-TM occaAtomicMin(TM *ptr, const TM &update) {
-  TM old;
-
-#  pragma omp critical
-  {
-    old  = *ptr;
-    *ptr = ((old < update) ? old : update);
-  }
-
-  return old;
-}
-
-template <class TM>
-TM occaAtomicMax(TM *ptr, const TM &update) {
-  TM old;
-
-#  pragma omp critical
-  {
-    old  = *ptr;
-    *ptr = ((old < update) ? update : old);
-  }
-
-  return old;
-}
-
-template <class TM>
-TM occaAtomicAnd(TM *ptr, const TM &update) {
-  TM old;
-
-#ifdef OPENMP_3_1
-#  pragma omp atomic capture
-#else
-#  pragma omp critical
-#endif
-  {
-    old   = *ptr;
-    *ptr &= update;
-  }
-
-  return old;
-}
-
-template <class TM>
-TM occaAtomicOr(TM *ptr, const TM &update) {
-  TM old;
-
-#ifdef OPENMP_3_1
-#  pragma omp atomic capture
-#else
-#  pragma omp critical
-#endif
-  {
-    old   = *ptr;
-    *ptr |= update;
-  }
-
-  return old;
-}
-
-template <class TM>
-TM occaAtomicXor(TM *ptr, const TM &update) {
-  TM old;
-
-#ifdef OPENMP_3_1
-#  pragma omp atomic capture
-#else
-#  pragma omp critical
-#endif
-  {
-    old   = *ptr;
-    *ptr ^= update;
-  }
-
-  return old;
-}
-
-template <class TM>
-TM occaAtomicCAS(TM *ptr, const int comp, const TM &update) {
-  TM old;
-
-#pragma omp critical
-  {
-    old = *ptr;
-    if (comp)
-      *ptr = update;
-  }
-
-  return old;
-}
-
-#define occaAtomicAdd64  occaAtomicAdd
-#define occaAtomicSub64  occaAtomicSub
-#define occaAtomicSwap64 occaAtomicSwap
-#define occaAtomicInc64  occaAtomicInc
-#define occaAtomicDec64  occaAtomicDec
-//================================================
-
-
 //---[ Misc ]-------------------------------------
 #undef occaKernelInfoArg
 #undef occaFunctionInfoArg
@@ -231,21 +46,40 @@ TM occaAtomicCAS(TM *ptr, const int comp, const TM &update) {
 #define occaFunctionInfoArg occa::serial::kernelInfoArg_t &occaKernelInfoArg_
 #define occaFunctionInfo    occaKernelInfoArg_
 
+// OCCA_OPENMP_FOR_CLAUSES and OCCA_OPENMP_PARALLEL_CLAUSES are set from
+//   the kernel's [openmp/...] properties
+#define OCCA_OPENMP_PRAGMA2(CLAUSES) OCCA_PRAGMA(#CLAUSES)
+#define OCCA_OPENMP_PRAGMA(CLAUSES)  OCCA_OPENMP_PRAGMA2(CLAUSES)
+
 #define occaParallelFor2                                                \
   occa::serial::kernelInfoArg_t occaKernelInfoArg_ = occaKernelInfoArg__; \
-  OCCA_PRAGMA("omp parallel for collapse(3) firstprivate(occaKernelInfoArg_)")
+  OCCA_OPENMP_PRAGMA(omp parallel for collapse(3) firstprivate(occaKernelInfoArg_) \
+                     OCCA_OPENMP_PARALLEL_CLAUSES OCCA_OPENMP_FOR_CLAUSES)
 
 #define occaParallelFor1                                                \
   occa::serial::kernelInfoArg_t occaKernelInfoArg_ = occaKernelInfoArg__; \
-  OCCA_PRAGMA("omp parallel for collapse(2) firstprivate(occaKernelInfoArg_)")
+  OCCA_OPENMP_PRAGMA(omp parallel for collapse(2) firstprivate(occaKernelInfoArg_) \
+                     OCCA_OPENMP_PARALLEL_CLAUSES OCCA_OPENMP_FOR_CLAUSES)
 
 #define occaParallelFor0                                                \
   occa::serial::kernelInfoArg_t occaKernelInfoArg_ = occaKernelInfoArg__; \
-  OCCA_PRAGMA("omp parallel for             firstprivate(occaKernelInfoArg_)")
+  OCCA_OPENMP_PRAGMA(omp parallel for             firstprivate(occaKernelInfoArg_) \
+                     OCCA_OPENMP_PARALLEL_CLAUSES OCCA_OPENMP_FOR_CLAUSES)
+
+#define occaParallelFor occaParallelFor0
+
+// Nested kernels run inside the parallel region opened by the launcher
+#define occaFusedFor2                                                   \
+  occa::serial::kernelInfoArg_t occaKernelInfoArg_ = occaKernelInfoArg__; \
+  OCCA_OPENMP_PRAGMA(omp for nowait collapse(3) OCCA_OPENMP_FOR_CLAUSES)
+
+#define occaFusedFor1                                                   \
+  occa::serial::kernelInfoArg_t occaKernelInfoArg_ = occaKernelInfoArg__; \
+  OCCA_OPENMP_PRAGMA(omp for nowait collapse(2) OCCA_OPENMP_FOR_CLAUSES)
 
-#define occaParallelFor                                                 \
+#define occaFusedFor0                                                   \
   occa::serial::kernelInfoArg_t occaKernelInfoArg_ = occaKernelInfoArg__; \
-  OCCA_PRAGMA("omp parallel for             firstprivate(occaKernelInfoArg_)")
+  OCCA_OPENMP_PRAGMA(omp for nowait             OCCA_OPENMP_FOR_CLAUSES)
 //================================================
 
 #endif
@@ -0,0 +1,76 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2014-2018 David Medina and Tim Warburton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ */
+
+#ifndef OCCA_SERIAL_COPYQUEUE_HEADER
+#define OCCA_SERIAL_COPYQUEUE_HEADER
+
+#include <queue>
+
+#include "occa/defines.hpp"
+#include "occa/tools/sys.hpp"
+
+namespace occa {
+  namespace serial {
+    class device;
+
+    // Runs async copies in order on a helper thread, kernel launches
+    //   and synchronous copies call finish() to keep stream ordering
+    class copyQueue {
+    private:
+      class asyncCopy {
+      public:
+        void *dest;
+        const void *src;
+        udim_t bytes;
+        bool nonTemporal;
+        bool isTransfer;
+      };
+
+      const device *dev;
+      std::queue<asyncCopy> copies;
+      bool isStopping;
+
+#if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
+      pthread_t thread;
+      pthread_mutex_t mutex;
+      pthread_cond_t hasCopies;
+      pthread_cond_t isIdle;
+
+      static void* worker(void *args);
+#endif
+
+    public:
+      copyQueue(const device *dev_);
+      ~copyQueue();
+
+      void push(void *dest,
+                const void *src,
+                const udim_t bytes,
+                const bool nonTemporal,
+                const bool isTransfer);
+
+      void finish();
+    };
+  }
+}
+
+#endif
@@ -28,8 +28,11 @@
 
 namespace occa {
   namespace serial {
+    class copyQueue;
+
     class device : public occa::device_v {
       mutable hash_t hash_;
+      mutable copyQueue *copies;
 
     public:
       device(const occa::properties &properties_);
@@ -70,7 +73,40 @@ namespace occa {
                                const void *src,
                                const occa::properties &props);
 
+      virtual memory_v* mmap(const std::string &filename,
+                             const udim_t offset,
+                             const udim_t bytes,
+                             const occa::properties &props);
+
       virtual udim_t memorySize() const;
+
+      // Touch (or copy into) new memory the way kernels will access it
+      //   so pages land on the NUMA node of the threads using them
+      virtual void firstTouch(char *ptr,
+                              const void *src,
+                              const udim_t bytes);
+
+      // Host copies used by serial::memory, [props]:
+      //   non-temporal: true  Use streaming stores (dest isn't read soon)
+      //   async: true         Queue the copy, launches and synchronous
+      //                         copies wait for it to finish
+      // [isTransfer] marks copies between the host and device memory
+      void copyBytes(void *dest,
+                     const void *src,
+                     const udim_t bytes,
+                     const occa::properties &props,
+                     const bool isTransfer = false) const;
+
+      virtual void bulkCopy(void *dest,
+                            const void *src,
+                            const udim_t bytes,
+                            const bool nonTemporal) const;
+
+      // Called after a transfer started at [startTime] is copied
+      virtual void finishTransfer(const udim_t bytes,
+                                  const double startTime) const;
+
+      void finishCopies() const;
       //  |=============================
     };
   }
@@ -35,63 +35,14 @@
 //================================================
 
 
-//---[ Atomics ]----------------------------------
-#define occaAtomicAdd(ptr, update) *(ptr) += (update)
-#define occaAtomicSub(ptr, update) *(ptr) -= (update)
-
-#define occaAtomicInc(ptr) ((*(ptr))++)
-#define occaAtomicDec(ptr) ((*(ptr))--)
-
-#define occaAtomicAnd(ptr, update) *(ptr) &= update
-#define occaAtomicOr(ptr, update)  *(ptr) |= update
-#define occaAtomicXor(ptr, update) *(ptr) ^= update
-
-template <class TM>
-TM occaAtomicSwap(TM *ptr, const TM &update) {
-  const TM old = *ptr;
-  *ptr = update;
-
-  return old;
-}
-
-template <class TM>
-TM occaAtomicMin(TM *ptr, const TM &update) {
-  const TM old = *ptr;
-  *ptr = ((old < update) ? old : update);
-
-  return old;
-}
-
-template <class TM>
-TM occaAtomicMax(TM *ptr, const TM &update) {
-  const TM old = *ptr;
-  *ptr = ((old < update) ? update : old);
-
-  return old;
-}
-
-template <class TM>
-TM occaAtomicCAS(TM *ptr, const int comp, const TM &update) {
-  TM old = *ptr;
-  if (comp) {
-    *ptr = update;
-  }
-  return old;
-}
-
-#define occaAtomicAdd64  occaAtomicAdd
-#define occaAtomicSub64  occaAtomicSub
-#define occaAtomicSwap64 occaAtomicSwap
-#define occaAtomicInc64  occaAtomicInc
-#define occaAtomicDec64  occaAtomicDec
-//================================================
-
-
 //---[ Misc ]-------------------------------------
 #define occaParallelFor2
 #define occaParallelFor1
 #define occaParallelFor0
 #define occaParallelFor
+#define occaFusedFor2
+#define occaFusedFor1
+#define occaFusedFor0
 //================================================
 
 #endif
@@ -30,10 +30,14 @@ namespace occa {
   namespace serial {
     class memory : public occa::memory_v {
     public:
+      // Set when [ptr] comes from sys::mallocPages or sys::mmapFile
+      udim_t mappedOffset, mappedBytes;
+
       memory(const occa::properties &properties_ = occa::properties());
       ~memory();
 
       kernelArg makeKernelArg() const;
+      kernelArg makeOffsetKernelArg(const udim_t offset) const;
 
       memory_v* addOffset(const dim_t offset, bool &needsFree);
 
@@ -55,6 +59,9 @@ namespace occa {
 
       void free();
       void detach();
+
+    private:
+      void finishCopies() const;
     };
   }
 }
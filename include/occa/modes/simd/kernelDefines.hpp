@@ -0,0 +1,65 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2014-2018 David Medina and Tim Warburton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ */
+
+#ifndef OCCA_SIMD_DEFINES_HEADER
+#define OCCA_SIMD_DEFINES_HEADER
+
+#include "occa/modes/serial/kernelDefines.hpp"
+
+//---[ Defines ]----------------------------------
+#define OCCA_USING_SIMD 1
+//================================================
+
+
+//---[ Loop Info ]--------------------------------
+// Inner ids are kernel-local integers instead of kernelInfoArg_t
+//   members so the inner-most loop is a canonical [omp simd] loop
+#undef occaInnerId2
+#undef occaInnerId1
+#undef occaInnerId0
+
+#define occaInnerId2 occaInnerId2_
+#define occaInnerId1 occaInnerId1_
+#define occaInnerId0 occaInnerId0_
+//================================================
+
+
+//---[ Loop Fors ]--------------------------------
+// The parser only emits [occaSimdInnerFor0] for inner loops whose
+//   iterations are independent (no exclusives, atomics or early exits)
+#define occaSimdInnerFor0 OCCA_PRAGMA("omp simd") occaInnerFor0
+//================================================
+
+
+//---[ Misc ]-------------------------------------
+#undef occaParallelFor2
+#undef occaParallelFor1
+#undef occaParallelFor0
+#undef occaParallelFor
+
+#define occaParallelFor2 int occaInnerId2_ = 0, occaInnerId1_ = 0, occaInnerId0_ = 0;
+#define occaParallelFor1 occaParallelFor2
+#define occaParallelFor0 occaParallelFor2
+#define occaParallelFor  occaParallelFor2
+//================================================
+
+#endif
@@ -114,7 +114,7 @@ namespace occa {
     //---[ Methods ]--------------------
     template <class TM>
     tag send(const int receiverID,
-             const occa::memory &data,
+             const occa::memoryView &data,
              const dim_t entries_ = -1,
              const int messageID  = defaultMessageID) {
       tag tag_;
@@ -149,7 +149,7 @@ namespace occa {
 
           data.copyTo(buffer,
                       count * sizeof(TM),
-                      offset);
+                      offset * sizeof(TM));
 
           MPI_Send(buffer,
                    count,
@@ -164,7 +164,7 @@ namespace occa {
 
     template <class TM>
     tag get(const int senderID,
-            occa::memory data,
+            occa::memoryView data,
             const dim_t entries_ = -1,
             const int messageID  = defaultMessageID) {
       tag tag_;
@@ -208,7 +208,7 @@ namespace occa {
 
           data.copyFrom(buffer,
                         count * sizeof(TM),
-                        offset);
+                        offset * sizeof(TM));
         }
       }
       return tag_;
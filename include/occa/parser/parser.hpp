@@ -57,6 +57,10 @@ namespace occa {
       //---[ Parser Warnings ]----------
       bool macrosAreInitialized;
       bool _compilingForCPU;
+      bool _vectorizeInnerLoops;
+      bool _fuseOuterLoopSets;
+      int _outerForCollapse;
+      bool _scalarizeExclusives;
       bool _warnForConditionalBarriers;
       bool _insertBarriersAutomatically;
       //================================
@@ -78,6 +82,10 @@ namespace occa {
       void setProperties(const occa::properties &properties_);
 
       bool compilingForCPU();
+      bool vectorizeInnerLoops();
+      bool fuseOuterLoopSets();
+      int outerForCollapse();
+      bool scalarizeExclusives();
       bool warnForConditionalBarriers();
       bool insertBarriersAutomatically();
       //================================
@@ -193,8 +201,25 @@ namespace occa {
                                                statementNode *snTail,
                                                bool isAppending = false);
 
+      bool exclusiveIsInInnerFor(statement &s);
+      void removeExclusiveQualifiers(statement &s);
+
+      void scalarizeExclusiveVariables(statement &s);
+      statement* getExclusiveInnerFor(statement &sOuter,
+                                      statement &sDecl,
+                                      varInfo &var);
+      void findVarUses(statement &s,
+                       statement &sDecl,
+                       varInfo &var,
+                       statementVector &uses);
+      statement* getThreadLocalInnerFor(statement &s,
+                                        statement &sOuter);
+
       void modifyExclusiveVariables(statement &s);
 
+      void markSimdInnerFors(statement &s);
+      bool innerForIsVectorizable(statement &s);
+
       void modifyTextureVariables();
 
       //   ---[ Load Kernels ]----------
@@ -227,6 +252,8 @@ namespace occa {
                                           statementVector &omLoops,
                                           varOriginMapVector &varDeps);
 
+      int collapseOuterFors(statement &omLoop);
+
       void addDepStatementsToKernel(statement &sKernel,
                                     varOriginMap_t &deps);
 
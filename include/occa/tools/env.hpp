@@ -47,7 +47,7 @@ namespace occa {
       if (v.size() == 0) {
         return defaultsTo;
       }
-      return fromString<TM>(var);
+      return fromString<TM>(v);
     }
 
     void signalExit(int sig);
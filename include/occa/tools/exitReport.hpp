@@ -0,0 +1,60 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2014-2018 David Medina and Tim Warburton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ */
+
+#ifndef OCCA_TOOLS_EXITREPORT_HEADER
+#define OCCA_TOOLS_EXITREPORT_HEADER
+
+#include <set>
+#include <string>
+
+namespace occa {
+  class exitReporter {
+  public:
+    virtual ~exitReporter();
+
+    // Prints to stderr, called once per registration
+    virtual void printExitReport() = 0;
+  };
+
+  // Reporters added while [envVar] is set print their report when the
+  //   program exits, or when they are removed before then
+  //
+  // Reports are never freed, reporters can be removed during static
+  //   destruction after the at-exit reports were printed
+  class exitReport {
+  private:
+    bool enabled;
+    std::set<exitReporter*> reporters;
+
+    exitReport(const std::string &envVar);
+
+  public:
+    static exitReport& get(const std::string &envVar);
+
+    void add(exitReporter *reporter);
+    void remove(exitReporter *reporter);
+
+    void printAll();
+  };
+}
+
+#endif
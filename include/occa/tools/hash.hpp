@@ -24,12 +24,17 @@
 #define OCCA_TOOLS_HASH_HEADER
 
 #include <iostream>
+#include <stdint.h>
 
 #include "occa/defines.hpp"
 #include "occa/types.hpp"
 
 namespace occa {
-  // Uses FNV hashing
+  // 256-bit hash built from four xxHash64-style lanes, reading 32-byte
+  //   stripes at a time. Each pair of h[] words is finalized from all
+  //   lanes with its own seed
+  //
+  // Changing the hash changes cache entries, see kc::cacheVersion
   class hash_t {
   public:
     bool initialized;
@@ -38,6 +43,13 @@ namespace occa {
     mutable std::string h_string;
     mutable int sh[8];
 
+    // Streaming state for update()
+    bool isStreaming;
+    uint64_t lanes[4];
+    unsigned char stripe[32];
+    int stripeBytes;
+    udim_t totalBytes;
+
     hash_t();
     hash_t(const int *h_);
     hash_t(const hash_t &hash);
@@ -45,6 +57,13 @@ namespace occa {
 
     void clear();
 
+    // Hashes [bytes] more bytes as if they were appended to the
+    //   previous input, hash(a + b) == hash(a).update(b)
+    // Hashes without an input (mixed with ^ or from fromString())
+    //   continue from their current value
+    hash_t& update(const void *ptr, const udim_t bytes);
+    hash_t& update(const std::string &str);
+
     inline bool isInitialized() const { return initialized; }
 
     bool operator < (const hash_t &fo) const;
@@ -40,6 +40,9 @@ namespace occa {
     extern const std::string sourceFile;
     extern const std::string binaryFile;
     extern const std::string infoFile;
+
+    // Bumped when cached files can't be reused, such as when hash_t changes
+    extern const std::string cacheVersion;
   }
 
   namespace env {
@@ -162,6 +165,8 @@ namespace occa {
 
     bool exists(const std::string &filename);
 
+    udim_t fileSize(const std::string &filename);
+
     char* c_read(const std::string &filename,
                  size_t *chars = NULL,
                  const bool readingBinary = false);
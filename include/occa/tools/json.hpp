@@ -40,13 +40,97 @@ namespace occa {
   typedef std::vector<json>       jsonArray;
   typedef std::vector<const json> cJsonArray_t;
 
-  typedef struct {
-    std::string string;
+  // Holds at most one of a string, object or array, allocated when
+  //   first accessed through a non-const accessor. Non-const accessors
+  //   error if a different container is held, only clear() and
+  //   useContainer() (explicit json type changes) drop it
+  // Copies share the container until one of them calls a non-const
+  //   accessor, which clones the container if it is still shared.
+  //   Non-const accessors also mark the container as unshareable since
+  //   the returned reference can outlive the call, later copies of it
+  //   are deep copies
+  // The edit accessors skip the marking, they are only used by json
+  //   methods that don't hand out the reference
+  // Const accessors return an empty container if another one is held
+  class jsonValue_t {
+  public:
+    enum container_t {
+      none_   = 0,
+      string_ = 1,
+      object_ = 2,
+      array_  = 3
+    };
+
     primitive number;
-    jsonObject object;
-    jsonArray array;
     bool boolean;
-  } jsonValue_t;
+
+  private:
+    container_t container;
+    void *ptr;
+
+  public:
+    jsonValue_t();
+    jsonValue_t(const jsonValue_t &value);
+    ~jsonValue_t();
+
+    jsonValue_t& operator = (const jsonValue_t &value);
+
+    void clear();
+    void useContainer(const container_t container_);
+
+    // False without a container or once the container has been
+    //   leaked through a non-const accessor
+    bool isShareable() const;
+
+    std::string& string();
+    jsonObject& object();
+    jsonArray& array();
+
+    std::string& editString();
+    jsonObject& editObject();
+    jsonArray& editArray();
+
+    const std::string& string() const;
+    const jsonObject& object() const;
+    const jsonArray& array() const;
+
+  private:
+    void freeContainer();
+    void copyContainer(const jsonValue_t &value);
+    void* mutableContainer(const container_t container_,
+                           const bool leak);
+  };
+
+  // Memoized json::hash() result, copies of a json share it until
+  //   either one is modified
+  // hash() is const and can run concurrently on a shared json, so the
+  //   memo is published atomically by the one thread that claims it
+  class jsonHashCache {
+  private:
+    enum state_t {
+      unset_   = 0,
+      storing_ = 1,
+      set_     = 2
+    };
+
+    int state;
+    int h[8];
+
+  public:
+    inline jsonHashCache() :
+      state(unset_) {}
+
+    jsonHashCache(const jsonHashCache &other);
+    jsonHashCache& operator = (const jsonHashCache &other);
+
+    // Only called while modifying the json, which is not thread-safe
+    inline void clear() {
+      state = unset_;
+    }
+
+    bool get(hash_t &hash) const;
+    void set(const hash_t &hash);
+  };
 
   class json {
   public:
@@ -64,6 +148,7 @@ namespace occa {
 
     type_t type;
     jsonValue_t value_;
+    mutable jsonHashCache cachedHash;
 
     inline json(type_t type_ = none_) {
       clear();
@@ -72,7 +157,8 @@ namespace occa {
 
     inline json(const json &j) :
       type(j.type),
-      value_(j.value_) {}
+      value_(j.value_),
+      cachedHash(j.cachedHash) {}
 
     inline json(const bool value) :
       type(boolean_) {
@@ -131,17 +217,17 @@ namespace occa {
 
     inline json(const std::string &value) :
       type(string_) {
-      value_.string = value;
+      value_.editString() = value;
     }
 
     inline json(const jsonObject &value) :
       type(object_) {
-      value_.object = value;
+      value_.editObject() = value;
     }
 
     inline json(const jsonArray &value) :
       type(array_) {
-      value_.array = value;
+      value_.editArray() = value;
     }
 
     json& clear();
@@ -149,92 +235,111 @@ namespace occa {
     json& operator = (const json &j);
 
     inline json& operator = (const char *c) {
+      cachedHash.clear();
       type = string_;
-      value_.string = c;
+      value_.useContainer(jsonValue_t::string_);
+      value_.editString() = c;
       return *this;
     }
 
     inline json& operator = (const std::string &value) {
+      cachedHash.clear();
       type = string_;
-      value_.string = value;
+      value_.useContainer(jsonValue_t::string_);
+      value_.editString() = value;
       return *this;
     }
 
     inline json& operator = (const bool value) {
+      cachedHash.clear();
       type = boolean_;
       value_.boolean = value;
       return *this;
     }
 
     inline json& operator = (const uint8_t value) {
+      cachedHash.clear();
       type = number_;
       value_.number = value;
       return *this;
     }
 
     inline json& operator = (const int8_t value) {
+      cachedHash.clear();
       type = number_;
       value_.number = value;
       return *this;
     }
 
     inline json& operator = (const uint16_t value) {
+      cachedHash.clear();
       type = number_;
       value_.number = value;
       return *this;
     }
 
     inline json& operator = (const int16_t value) {
+      cachedHash.clear();
       type = number_;
       value_.number = value;
       return *this;
     }
 
     inline json& operator = (const uint32_t value) {
+      cachedHash.clear();
       type = number_;
       value_.number = value;
       return *this;
     }
 
     inline json& operator = (const int32_t value) {
+      cachedHash.clear();
       type = number_;
       value_.number = value;
       return *this;
     }
 
     inline json& operator = (const uint64_t value) {
+      cachedHash.clear();
       type = number_;
       value_.number = value;
       return *this;
     }
 
     inline json& operator = (const int64_t value) {
+      cachedHash.clear();
       type = number_;
       value_.number = value;
       return *this;
     }
 
     inline json& operator = (const double value) {
+      cachedHash.clear();
       type = number_;
       value_.number = value;
       return *this;
     }
 
     inline json& operator = (const primitive &value) {
+      cachedHash.clear();
       type = number_;
       value_.number = value;
       return *this;
     }
 
     inline json& operator = (const jsonObject &value) {
+      cachedHash.clear();
       type = object_;
-      value_.object = value;
+      value_.useContainer(jsonValue_t::object_);
+      value_.editObject() = value;
       return *this;
     }
 
     inline json& operator = (const jsonArray &value) {
+      cachedHash.clear();
       type = array_;
-      value_.array = value;
+      value_.useContainer(jsonValue_t::array_);
+      value_.editArray() = value;
       return *this;
     }
 
@@ -286,52 +391,65 @@ namespace occa {
     }
 
     inline json& asString() {
+      cachedHash.clear();
       type = string_;
+      value_.useContainer(jsonValue_t::string_);
       return *this;
     }
 
     inline json& asNumber() {
+      cachedHash.clear();
       type = number_;
       return *this;
     }
 
     inline json& asObject() {
+      cachedHash.clear();
       type = object_;
+      value_.useContainer(jsonValue_t::object_);
       return *this;
     }
 
     inline json& asArray() {
+      cachedHash.clear();
       type = array_;
+      value_.useContainer(jsonValue_t::array_);
       return *this;
     }
 
     inline json& asBoolean() {
+      cachedHash.clear();
       type = boolean_;
       return *this;
     }
 
     inline std::string& string() {
-      return value_.string;
+      cachedHash.clear();
+      return value_.string();
     }
 
     inline primitive& number() {
+      cachedHash.clear();
       return value_.number;
     }
 
     inline jsonObject& object() {
-      return value_.object;
+      cachedHash.clear();
+      return value_.object();
     }
 
     inline jsonArray& array() {
-      return value_.array;
+      cachedHash.clear();
+      return value_.array();
     }
 
     inline bool& boolean() {
+      cachedHash.clear();
       return value_.boolean;
     }
 
     inline const std::string& string() const {
-      return value_.string;
+      return value_.string();
     }
 
     inline const primitive& number() const {
@@ -339,11 +457,11 @@ namespace occa {
     }
 
     inline const jsonObject& object() const {
-      return value_.object;
+      return value_.object();
     }
 
     inline const jsonArray& array() const {
-      return value_.array;
+      return value_.array();
     }
 
     inline bool boolean() const {
@@ -381,8 +499,8 @@ namespace occa {
           ++c;
         }
 
-        cJsonObjectIterator it = j->value_.object.find(key);
-        if (it == j->value_.object.end()) {
+        cJsonObjectIterator it = j->value_.object().find(key);
+        if (it == j->value_.object().end()) {
           return default_;
         }
         j = &(it->second);
@@ -419,8 +537,8 @@ namespace occa {
           ++c;
         }
 
-        cJsonObjectIterator it = j->value_.object.find(key);
-        if (it == j->value_.object.end()) {
+        cJsonObjectIterator it = j->value_.object().find(key);
+        if (it == j->value_.object().end()) {
           return default_;
         }
         j = &(it->second);
@@ -429,10 +547,10 @@ namespace occa {
         return default_;
       }
 
-      const int entries = (int) j->value_.array.size();
+      const int entries = (int) j->value_.array().size();
       std::vector<TM> ret;
       for (int i = 0; i < entries; ++i) {
-        ret.push_back((TM) j->value_.array[i]);
+        ret.push_back((TM) j->value_.array()[i]);
       }
       return ret;
     }
@@ -462,13 +580,13 @@ namespace occa {
       case none_:
         return true;
       case string_:
-        return value_.string == j.value_.string;
+        return value_.string() == j.value_.string();
       case number_:
         return equal(value_.number, j.value_.number);
       case object_:
-        return value_.object == j.value_.object;
+        return value_.object() == j.value_.object();
       case array_:
-        return value_.array == j.value_.array;
+        return value_.array() == j.value_.array();
       case boolean_:
         return value_.boolean == j.value_.boolean;
       case null_:
@@ -523,9 +641,13 @@ namespace occa {
     }
 
     inline operator std::string () const {
-      return value_.string;
+      return value_.string();
     }
 
+    // Structural hash, independent of the object key insertion order
+    //   and of formatting. Only nodes with a shareable container
+    //   memoize their hash, nothing outside the node's own methods can
+    //   modify them. Nodes that handed out references are rehashed
     hash_t hash() const;
 
     std::string toString(const int indent = 2) const;
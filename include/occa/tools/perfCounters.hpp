@@ -0,0 +1,113 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2014-2018 David Medina and Tim Warburton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ */
+
+#ifndef OCCA_TOOLS_PERFCOUNTERS_HEADER
+#define OCCA_TOOLS_PERFCOUNTERS_HEADER
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "occa/defines.hpp"
+#include "occa/types.hpp"
+
+namespace occa {
+  namespace perfCounter {
+    static const int cycles       = (1 << 0);
+    static const int instructions = (1 << 1);
+    static const int llcMisses    = (1 << 2);
+    static const int memoryBytes  = (1 << 3);
+  }
+
+  //---[ perfCounterValues ]------------
+  class perfCounterValues {
+  public:
+    // perfCounter flags of the counters that could be read
+    int available;
+
+    udim_t cycles;
+    udim_t instructions;
+    udim_t llcMisses;
+    // DRAM traffic from the memory controllers, counted system-wide
+    udim_t memoryBytes;
+
+    perfCounterValues();
+
+    perfCounterValues operator - (const perfCounterValues &values) const;
+    perfCounterValues& operator += (const perfCounterValues &values);
+
+    // Returns true if every counter in [counters] is available
+    bool has(const int counters) const;
+  };
+  //====================================
+
+  //---[ perfCounters ]-----------------
+  // Linux perf_event counters for every thread in the process
+  //
+  // Threads are picked up on each read() so worker pools created
+  //   after the counters are included. Memory bandwidth uses the
+  //   uncore_imc PMUs when they exist and perf_event_paranoid allows it
+  //
+  // Counting needs perf_event_paranoid <= 2 (user-space only) and is
+  //   a no-op on other platforms
+  class perfCounters {
+  private:
+    // fds[0] leads the group so one read() returns every counter
+    class threadCounters {
+    public:
+      std::vector<int> fds;
+      std::vector<int> counters;
+    };
+
+    class memoryCounter {
+    public:
+      int fd;
+      udim_t bytesPerCount;
+    };
+
+    bool isSetup;
+    std::map<int, threadCounters> threads;
+    perfCounterValues exitedThreadValues;
+    std::vector<memoryCounter> memoryCounters;
+
+    perfCounters(const perfCounters &c);
+    perfCounters& operator = (const perfCounters &c);
+
+  public:
+    perfCounters();
+    ~perfCounters();
+
+    // Returns false if no counter could be opened
+    bool setup();
+    void free();
+
+    perfCounterValues read();
+
+  private:
+    void addNewThreads();
+    void addThread(const int tid);
+    void addMemoryCounters();
+  };
+  //====================================
+}
+
+#endif
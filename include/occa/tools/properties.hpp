@@ -28,6 +28,24 @@
 namespace occa {
   class properties: public json {
   public:
+    // Path split into its keys once, to be reused in lookups against
+    //   any properties object
+    class path {
+    public:
+      std::string str;
+      strVector keys;
+
+      explicit path(const char *c);
+      explicit path(const std::string &s);
+
+    private:
+      void split();
+    };
+
+    using json::has;
+    using json::get;
+    using json::operator [];
+
     properties();
     properties(const json &j);
     properties(const char *c);
@@ -40,9 +58,23 @@ namespace occa {
 
     inline properties operator + (const properties &p) const {
       properties ret = *this;
-      ret.mergeWithObject(p.value_.object);
+      ret.mergeWithObject(p.value_.object());
       return ret;
     }
+
+    // Returns NULL if [p] is missing or goes through a non-object
+    const json* find(const path &p) const;
+
+    bool has(const path &p) const;
+
+    json& operator [] (const path &p);
+    const json& operator [] (const path &p) const;
+
+    template <class TM>
+    TM get(const path &p, const TM &default_ = TM()) const {
+      const json *j = find(p);
+      return j ? (TM) *j : default_;
+    }
   };
 
   template <>
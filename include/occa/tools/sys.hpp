@@ -65,6 +65,7 @@ namespace occa {
 
     //---[ System Info ]----------------
     double currentTime();
+    void sleep(const double seconds);
     std::string date();
     std::string humanDate();
     //==================================
@@ -114,6 +115,32 @@ namespace occa {
     void* malloc(udim_t bytes);
     void free(void *ptr);
 
+    // memcpy with streaming stores, skipping the cache for [dest]
+    void nonTemporalMemcpy(void *dest,
+                           const void *src,
+                           const udim_t bytes);
+
+    // Page-backed allocations, [mappedBytes] is needed to free them
+    void* mallocPages(const udim_t bytes,
+                      const bool hugepages,
+                      const bool transparentHugepages,
+                      udim_t &mappedBytes);
+    void freePages(void *ptr, const udim_t mappedBytes);
+
+    // [mapping] is one of: readonly, private, shared
+    //   Returns the mapped [offset], pages start at (ptr - mappedOffset)
+    void* mmapFile(const std::string &filename,
+                   const udim_t offset,
+                   const udim_t bytes,
+                   const std::string &mapping,
+                   udim_t &mappedOffset,
+                   udim_t &mappedBytes);
+
+    // [policy] is one of: local, interleave, node:<n>
+    void setNumaPolicy(void *ptr,
+                       const udim_t bytes,
+                       const std::string &policy);
+
     void* dlopen(const std::string &filename,
                  const hash_t &hash = hash_t(),
                  const std::string &hashTag = "");
@@ -0,0 +1,74 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2014-2018 David Medina and Tim Warburton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ */
+
+#ifndef OCCA_TOOLS_TRACE_HEADER
+#define OCCA_TOOLS_TRACE_HEADER
+
+#include <string>
+
+#include "occa/defines.hpp"
+#include "occa/types.hpp"
+
+namespace occa {
+  namespace trace {
+    // Set through OCCA_TRACE=<file>, events are written to <file> as
+    //   Chrome trace JSON (chrome://tracing, Perfetto) at exit
+    // Accessed atomically, flush() clears it to stop recording
+    extern bool enabled;
+
+    class event {
+    public:
+      const char *category;
+      std::string name;
+      std::string args;
+      double start, duration;
+    };
+
+    // Records the time between its construction and destruction
+    class scope {
+    private:
+      bool isActive;
+      event e;
+
+    public:
+      scope(const char *category,
+            const char *name);
+
+      scope(const char *category,
+            const std::string &name);
+
+      ~scope();
+
+      void addArg(const char *key, const udim_t value);
+      void addArg(const char *key, const std::string &value);
+
+    private:
+      void start(const char *category);
+    };
+
+    // Events are buffered per thread without locking
+    void record(const event &e);
+    void flush();
+  }
+}
+
+#endif
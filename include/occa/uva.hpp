@@ -24,10 +24,13 @@
 #define OCCA_UVA_HEADER
 
 #include <iostream>
+#include <map>
+#include <set>
 #include <vector>
 
 #include "occa/defines.hpp"
 #include "occa/types.hpp"
+#include "occa/tools/sys.hpp"
 
 namespace occa {
   class device;
@@ -49,8 +52,67 @@ namespace occa {
     friend int operator < (const ptrRange &a, const ptrRange &b);
   };
 
-  typedef std::map<ptrRange, occa::memory_v*> ptrRangeMap;
-  typedef std::vector<occa::memory_v*>        memoryVector;
+  //---[ ptrRangeMap ]------------------
+  // Sorted array of address ranges searched with a binary search
+  //
+  // Readers search the published array without locking. Updates are
+  //   queued and merged in one O(n + k log k) pass by the first lookup
+  //   after them, which is the only lookup that locks.
+  //   Replaced arrays are freed once no reader is active.
+  class ptrRangeMap {
+  public:
+    class entry {
+    public:
+      char *start, *end;
+      occa::memory_v *mem;
+
+      entry();
+      entry(const ptrRange &range,
+            occa::memory_v *mem_);
+
+      // Empty ranges only match their start
+      inline bool contains(const char *ptr) const {
+        return (((start <= ptr) && (ptr < end)) ||
+                (start == ptr));
+      }
+    };
+
+    typedef std::vector<entry> entryVector;
+
+  private:
+    entryVector *entries;
+    std::vector<entryVector*> retiredEntries;
+
+    std::map<char*, entry> pendingInserts;
+    std::set<char*> pendingErases;
+
+    mutex writeMutex;
+    int isDirty;
+    int activeReaders;
+
+    ptrRangeMap(const ptrRangeMap &m);
+    ptrRangeMap& operator = (const ptrRangeMap &m);
+
+    void publish();
+    void freeRetiredEntries();
+    occa::memory_v* findPending(const char *ptr);
+
+  public:
+    ptrRangeMap();
+    ~ptrRangeMap();
+
+    void insert(const ptrRange &range,
+                occa::memory_v *mem);
+    void erase(const void *ptr);
+
+    // Returns NULL if [ptr] isn't in a range
+    occa::memory_v* find(const void *ptr);
+
+    size_t size();
+  };
+  //====================================
+
+  typedef std::vector<occa::memory_v*> memoryVector;
 
   extern ptrRangeMap uvaMap;
   extern memoryVector uvaStaleMemory;
@@ -91,9 +153,13 @@ namespace occa {
   void sync(void *ptr);
   void dontSync(void *ptr);
 
+  void addToStaleMap(memory_v *mem);
   void removeFromStaleMap(void *ptr);
   void removeFromStaleMap(memory_v *mem);
 
+  // Reports host writes to [ptr, ptr + bytes) in a UVA allocation
+  void markDirty(void *ptr, const udim_t bytes = (udim_t) -1);
+
   void setupMagicFor(void *ptr);
 
   void free(void *ptr);
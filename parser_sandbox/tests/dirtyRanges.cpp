@@ -0,0 +1,186 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2014-2018 David Medina and Tim Warburton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ */
+
+#include "occa.hpp"
+
+void testAdd();
+void testRemove();
+void testSync();
+
+bool hasRanges(const occa::dirtyRanges::rangeVector &ranges,
+               const occa::udim_t *expected,
+               const int count);
+bool hasRanges(const occa::dirtyRanges &dirty,
+               const occa::udim_t *expected,
+               const int count);
+
+int main(const int argc, const char **argv) {
+  testAdd();
+  testRemove();
+  testSync();
+  return 0;
+}
+
+// [expected] holds [start, end) pairs
+bool hasRanges(const occa::dirtyRanges::rangeVector &ranges,
+               const occa::udim_t *expected,
+               const int count) {
+  if ((int) ranges.size() != count) {
+    return false;
+  }
+  for (int i = 0; i < count; ++i) {
+    if ((ranges[i].first  != expected[2*i]) ||
+        (ranges[i].second != expected[2*i + 1])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool hasRanges(const occa::dirtyRanges &dirty,
+               const occa::udim_t *expected,
+               const int count) {
+  return hasRanges(dirty.ranges, expected, count);
+}
+
+void testAdd() {
+  occa::dirtyRanges dirty;
+  OCCA_ASSERT_TRUE(dirty.isEmpty());
+
+  dirty.add(10, 20);
+  dirty.add(30, 40);
+  dirty.add(5, 8);
+  const occa::udim_t sorted[] = {5, 8, 10, 20, 30, 40};
+  OCCA_ASSERT_TRUE(hasRanges(dirty, sorted, 3));
+  OCCA_ASSERT_EQUAL(dirty.bytes(), (occa::udim_t) 23);
+
+  // Adjacent and overlapping ranges merge
+  dirty.add(20, 25);
+  dirty.add(35, 50);
+  const occa::udim_t merged[] = {5, 8, 10, 25, 30, 50};
+  OCCA_ASSERT_TRUE(hasRanges(dirty, merged, 3));
+
+  // Bridging several ranges
+  dirty.add(7, 31);
+  const occa::udim_t bridged[] = {5, 50};
+  OCCA_ASSERT_TRUE(hasRanges(dirty, bridged, 1));
+
+  // Empty ranges are ignored
+  dirty.add(60, 60);
+  OCCA_ASSERT_TRUE(hasRanges(dirty, bridged, 1));
+
+  dirty.clear();
+  OCCA_ASSERT_TRUE(dirty.isEmpty());
+  OCCA_ASSERT_EQUAL(dirty.bytes(), (occa::udim_t) 0);
+}
+
+void testRemove() {
+  occa::dirtyRanges dirty;
+  occa::dirtyRanges::rangeVector removed;
+
+  dirty.add(0, 10);
+  dirty.add(20, 30);
+  dirty.add(40, 50);
+
+  // Splits the ranges it cuts through
+  dirty.remove(5, 25, removed);
+  const occa::udim_t removedPieces[] = {5, 10, 20, 25};
+  const occa::udim_t kept[] = {0, 5, 25, 30, 40, 50};
+  OCCA_ASSERT_TRUE(hasRanges(removed, removedPieces, 2));
+  OCCA_ASSERT_TRUE(hasRanges(dirty, kept, 3));
+
+  // Removing from the middle of a range
+  removed.clear();
+  dirty.remove(42, 44, removed);
+  const occa::udim_t middle[] = {42, 44};
+  const occa::udim_t keptMiddle[] = {0, 5, 25, 30, 40, 42, 44, 50};
+  OCCA_ASSERT_TRUE(hasRanges(removed, middle, 1));
+  OCCA_ASSERT_TRUE(hasRanges(dirty, keptMiddle, 4));
+
+  // Nothing dirty in the range
+  removed.clear();
+  dirty.remove(10, 20, removed);
+  OCCA_ASSERT_TRUE(removed.empty());
+  OCCA_ASSERT_TRUE(hasRanges(dirty, keptMiddle, 4));
+
+  removed.clear();
+  dirty.remove(0, 100, removed);
+  OCCA_ASSERT_EQUAL((int) removed.size(), 4);
+  OCCA_ASSERT_TRUE(dirty.isEmpty());
+}
+
+void testSync() {
+  occa::device device(
+    occa::properties(std::string("mode: 'Emulated',"
+                                 "latency: 0,"))
+  );
+
+  const int entries = 16;
+  const occa::udim_t bytes = entries * sizeof(int);
+  int *a = (int*) device.umalloc(bytes);
+  int deviceCopy[entries];
+
+  occa::memory mem(a);
+  for (int i = 0; i < entries; ++i) {
+    a[i] = i;
+  }
+  occa::syncToDevice(a);
+
+  // Opting in marks everything dirty
+  mem.markDirty();
+  OCCA_ASSERT_EQUAL(mem.dirtyBytes(), bytes);
+  occa::syncToDevice(a);
+  OCCA_ASSERT_EQUAL(mem.dirtyBytes(), (occa::udim_t) 0);
+
+  // Only reported writes are copied
+  a[3] = 100;
+  a[9] = 100;
+  occa::markDirty(a + 3, sizeof(int));
+  OCCA_ASSERT_EQUAL(mem.dirtyBytes(), (occa::udim_t) sizeof(int));
+
+  occa::syncToDevice(a);
+  OCCA_ASSERT_EQUAL(mem.dirtyBytes(), (occa::udim_t) 0);
+
+  mem.copyTo(deviceCopy);
+  OCCA_ASSERT_EQUAL(deviceCopy[3], 100);
+  OCCA_ASSERT_EQUAL(deviceCopy[9], 9);
+
+  // Partial syncs keep the dirty ranges outside them
+  a[0] = 200;
+  a[12] = 200;
+  occa::markDirty(a, sizeof(int));
+  occa::markDirty(a + 12, sizeof(int));
+  mem.syncToDevice(sizeof(int), 12 * sizeof(int));
+  OCCA_ASSERT_EQUAL(mem.dirtyBytes(), (occa::udim_t) sizeof(int));
+
+  mem.copyTo(deviceCopy);
+  OCCA_ASSERT_EQUAL(deviceCopy[0], 0);
+  OCCA_ASSERT_EQUAL(deviceCopy[12], 200);
+
+  // Syncing to the host overwrites the dirty writes
+  occa::syncToHost(a);
+  OCCA_ASSERT_EQUAL(mem.dirtyBytes(), (occa::udim_t) 0);
+  OCCA_ASSERT_EQUAL(a[0], 0);
+
+  occa::free(a);
+  device.free();
+}
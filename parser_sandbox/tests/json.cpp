@@ -23,6 +23,7 @@
 
 #include "occa/tools/io.hpp"
 #include "occa/tools/json.hpp"
+#include "occa/tools/properties.hpp"
 #include "occa/tools/string.hpp"
 #include "occa/tools/testing.hpp"
 
@@ -32,6 +33,12 @@ void testObject();
 void testArray();
 void testKeywords();
 void testMethods();
+void testTypeChanges();
+void testHash();
+void testHashUpdate();
+void testCopies();
+void testRoundTrip();
+void testPropertyPaths();
 
 int main(const int argc, const char **argv) {
   testString();
@@ -40,6 +47,12 @@ int main(const int argc, const char **argv) {
   testArray();
   testKeywords();
   testMethods();
+  testTypeChanges();
+  testHash();
+  testHashUpdate();
+  testCopies();
+  testRoundTrip();
+  testPropertyPaths();
   return 0;
 }
 
@@ -49,53 +62,53 @@ void testString() {
   // Normal strings
   j.load("\"A\"");
   OCCA_ASSERT_EQUAL(occa::json::string_, j.type);
-  OCCA_ASSERT_EQUAL("A", j.value_.string);
+  OCCA_ASSERT_EQUAL("A", j.value_.string());
   j.load("'A'");
   OCCA_ASSERT_EQUAL(occa::json::string_, j.type);
-  OCCA_ASSERT_EQUAL("A", j.value_.string);
+  OCCA_ASSERT_EQUAL("A", j.value_.string());
   j.load("\"A'\"");
   OCCA_ASSERT_EQUAL(occa::json::string_, j.type);
-  OCCA_ASSERT_EQUAL("A'", j.value_.string);
+  OCCA_ASSERT_EQUAL("A'", j.value_.string());
   j.load("'A\"'");
   OCCA_ASSERT_EQUAL(occa::json::string_, j.type);
-  OCCA_ASSERT_EQUAL("A\"", j.value_.string);
+  OCCA_ASSERT_EQUAL("A\"", j.value_.string());
 
   // Special chars
   j.load("\"\\\"\"");
   OCCA_ASSERT_EQUAL(occa::json::string_, j.type);
-  OCCA_ASSERT_EQUAL("\"", j.value_.string);
+  OCCA_ASSERT_EQUAL("\"", j.value_.string());
   j.load("\"\\\\\"");
   OCCA_ASSERT_EQUAL(occa::json::string_, j.type);
-  OCCA_ASSERT_EQUAL("\\", j.value_.string);
+  OCCA_ASSERT_EQUAL("\\", j.value_.string());
   j.load("\"\\/\"");
   OCCA_ASSERT_EQUAL(occa::json::string_, j.type);
-  OCCA_ASSERT_EQUAL("/", j.value_.string);
+  OCCA_ASSERT_EQUAL("/", j.value_.string());
   j.load("\"\\b\"");
   OCCA_ASSERT_EQUAL(occa::json::string_, j.type);
-  OCCA_ASSERT_EQUAL("\b", j.value_.string);
+  OCCA_ASSERT_EQUAL("\b", j.value_.string());
   j.load("\"\\f\"");
   OCCA_ASSERT_EQUAL(occa::json::string_, j.type);
-  OCCA_ASSERT_EQUAL("\f", j.value_.string);
+  OCCA_ASSERT_EQUAL("\f", j.value_.string());
   j.load("\"\\n\"");
   OCCA_ASSERT_EQUAL(occa::json::string_, j.type);
-  OCCA_ASSERT_EQUAL("\n", j.value_.string);
+  OCCA_ASSERT_EQUAL("\n", j.value_.string());
   j.load("\"\\r\"");
   OCCA_ASSERT_EQUAL(occa::json::string_, j.type);
-  OCCA_ASSERT_EQUAL("\r", j.value_.string);
+  OCCA_ASSERT_EQUAL("\r", j.value_.string());
   j.load("\"\\t\"");
   OCCA_ASSERT_EQUAL(occa::json::string_, j.type);
-  OCCA_ASSERT_EQUAL("\t", j.value_.string);
+  OCCA_ASSERT_EQUAL("\t", j.value_.string());
 
   // Test unicode
   j.load("\"\\u0123 \\u4567 \\u89AB \\uCDEF\"");
   OCCA_ASSERT_EQUAL(occa::json::string_, j.type);
   OCCA_ASSERT_EQUAL("\\u0123 \\u4567 \\u89AB \\uCDEF",
-                    j.value_.string);
+                    j.value_.string());
 
   j.load("\"\\u0123 \\u4567 \\u89ab \\ucdef\"");
   OCCA_ASSERT_EQUAL(occa::json::string_, j.type);
   OCCA_ASSERT_EQUAL("\\u0123 \\u4567 \\u89ab \\ucdef",
-                    j.value_.string);
+                    j.value_.string());
 }
 
 void testNumber() {
@@ -135,32 +148,32 @@ void testObject() {
 
   j.load("{\"0\":0, \"1\":1}");
   OCCA_ASSERT_EQUAL(occa::json::object_, j.type);
-  OCCA_ASSERT_EQUAL(2, (int) j.value_.object.size());
-  OCCA_ASSERT_EQUAL(0, (int) j.value_.object["0"]);
-  OCCA_ASSERT_EQUAL(1, (int) j.value_.object["1"]);
+  OCCA_ASSERT_EQUAL(2, (int) j.value_.object().size());
+  OCCA_ASSERT_EQUAL(0, (int) j.value_.object()["0"]);
+  OCCA_ASSERT_EQUAL(1, (int) j.value_.object()["1"]);
 
   j.load("{\"0\":0, \"1\":1,}");
   OCCA_ASSERT_EQUAL(occa::json::object_, j.type);
-  OCCA_ASSERT_EQUAL(2, (int) j.value_.object.size());
-  OCCA_ASSERT_EQUAL(occa::json::number_, j.value_.object["0"].type);
-  OCCA_ASSERT_EQUAL(occa::json::number_, j.value_.object["1"].type);
-  OCCA_ASSERT_EQUAL(0, (int) j.value_.object["0"]);
-  OCCA_ASSERT_EQUAL(1, (int) j.value_.object["1"]);
+  OCCA_ASSERT_EQUAL(2, (int) j.value_.object().size());
+  OCCA_ASSERT_EQUAL(occa::json::number_, j.value_.object()["0"].type);
+  OCCA_ASSERT_EQUAL(occa::json::number_, j.value_.object()["1"].type);
+  OCCA_ASSERT_EQUAL(0, (int) j.value_.object()["0"]);
+  OCCA_ASSERT_EQUAL(1, (int) j.value_.object()["1"]);
 
   // Short-hand notation
   j.load("{0:0, 1:1}");
   OCCA_ASSERT_EQUAL(occa::json::object_, j.type);
-  OCCA_ASSERT_EQUAL(2, (int) j.value_.object.size());
-  OCCA_ASSERT_EQUAL(0, (int) j.value_.object["0"]);
-  OCCA_ASSERT_EQUAL(1, (int) j.value_.object["1"]);
+  OCCA_ASSERT_EQUAL(2, (int) j.value_.object().size());
+  OCCA_ASSERT_EQUAL(0, (int) j.value_.object()["0"]);
+  OCCA_ASSERT_EQUAL(1, (int) j.value_.object()["1"]);
 
   j.load("{0:0, 1:1,}");
   OCCA_ASSERT_EQUAL(occa::json::object_, j.type);
-  OCCA_ASSERT_EQUAL(2, (int) j.value_.object.size());
-  OCCA_ASSERT_EQUAL(occa::json::number_, j.value_.object["0"].type);
-  OCCA_ASSERT_EQUAL(occa::json::number_, j.value_.object["1"].type);
-  OCCA_ASSERT_EQUAL(0, (int) j.value_.object["0"]);
-  OCCA_ASSERT_EQUAL(1, (int) j.value_.object["1"]);
+  OCCA_ASSERT_EQUAL(2, (int) j.value_.object().size());
+  OCCA_ASSERT_EQUAL(occa::json::number_, j.value_.object()["0"].type);
+  OCCA_ASSERT_EQUAL(occa::json::number_, j.value_.object()["1"].type);
+  OCCA_ASSERT_EQUAL(0, (int) j.value_.object()["0"]);
+  OCCA_ASSERT_EQUAL(1, (int) j.value_.object()["1"]);
 
   // Test path
   j.load("{0: {1: {2: {3: 3}}}}");
@@ -172,21 +185,21 @@ void testArray() {
 
   j.load("[1, 2]");
   OCCA_ASSERT_EQUAL(occa::json::array_, j.type);
-  OCCA_ASSERT_EQUAL(2, (int) j.value_.array.size());
+  OCCA_ASSERT_EQUAL(2, (int) j.value_.array().size());
 
-  OCCA_ASSERT_EQUAL(occa::json::number_, j.value_.array[0].type);
-  OCCA_ASSERT_EQUAL(occa::json::number_, j.value_.array[1].type);
-  OCCA_ASSERT_EQUAL(1, (int) j.value_.array[0]);
-  OCCA_ASSERT_EQUAL(2, (int) j.value_.array[1]);
+  OCCA_ASSERT_EQUAL(occa::json::number_, j.value_.array()[0].type);
+  OCCA_ASSERT_EQUAL(occa::json::number_, j.value_.array()[1].type);
+  OCCA_ASSERT_EQUAL(1, (int) j.value_.array()[0]);
+  OCCA_ASSERT_EQUAL(2, (int) j.value_.array()[1]);
 
   j.load("[1, 2,]");
   OCCA_ASSERT_EQUAL(occa::json::array_, j.type);
-  OCCA_ASSERT_EQUAL(2, (int) j.value_.array.size());
+  OCCA_ASSERT_EQUAL(2, (int) j.value_.array().size());
 
-  OCCA_ASSERT_EQUAL(occa::json::number_, j.value_.array[0].type);
-  OCCA_ASSERT_EQUAL(occa::json::number_, j.value_.array[1].type);
-  OCCA_ASSERT_EQUAL(1, (int) j.value_.array[0]);
-  OCCA_ASSERT_EQUAL(2, (int) j.value_.array[1]);
+  OCCA_ASSERT_EQUAL(occa::json::number_, j.value_.array()[0].type);
+  OCCA_ASSERT_EQUAL(occa::json::number_, j.value_.array()[1].type);
+  OCCA_ASSERT_EQUAL(1, (int) j.value_.array()[0]);
+  OCCA_ASSERT_EQUAL(2, (int) j.value_.array()[1]);
 }
 
 void testKeywords() {
@@ -211,3 +224,241 @@ void testMethods() {
   OCCA_ASSERT_EQUAL("a", keys[0]);
   OCCA_ASSERT_EQUAL("b", keys[1]);
 }
+
+void testTypeChanges() {
+  occa::json j;
+
+  // Explicit type changes replace the held container
+  j.load("{a: 1, b: [1, 2]}");
+  j = "A";
+  OCCA_ASSERT_EQUAL(occa::json::string_, j.type);
+  OCCA_ASSERT_EQUAL("A", j.string());
+
+  j.asArray();
+  OCCA_ASSERT_EQUAL(occa::json::array_, j.type);
+  OCCA_ASSERT_EQUAL(0, j.size());
+  j += occa::json(1);
+  OCCA_ASSERT_EQUAL(1, j.size());
+
+  // Numbers and booleans don't drop the container
+  j.load("[1, 2]");
+  j.asNumber();
+  j.asArray();
+  OCCA_ASSERT_EQUAL(2, j.size());
+
+  // Const accessors of other containers are empty
+  const occa::json &cj = j;
+  OCCA_ASSERT_EQUAL(0, (int) cj.object().size());
+  OCCA_ASSERT_EQUAL("", cj.string());
+}
+
+void testHash() {
+  occa::json j;
+
+  // Key order and formatting don't change the hash
+  j.load("{a: {b: {c: 1}}, d: [1, 2]}");
+  const occa::hash_t hash = j.hash();
+  OCCA_ASSERT_TRUE(hash == occa::json::parse("{ d: [1,2], a: { b: { c: 1 } } }").hash());
+
+  // Nested changes drop the memoized hashes on their path
+  j["a/b/c"] = 2;
+  OCCA_ASSERT_TRUE(hash != j.hash());
+  j["a/b/c"] = 1;
+  OCCA_ASSERT_TRUE(hash == j.hash());
+
+  j["d"] += occa::json(3);
+  OCCA_ASSERT_TRUE(hash != j.hash());
+  j["d"] = occa::json::parse("[1, 2]");
+  OCCA_ASSERT_TRUE(hash == j.hash());
+
+  // Copies keep their own memo
+  occa::json copy = j;
+  copy["a/b/c"] = 3;
+  OCCA_ASSERT_TRUE(hash == j.hash());
+  OCCA_ASSERT_TRUE(hash != copy.hash());
+
+  // Writes through references held across a hash() change it
+  occa::properties props("defines: {A: 1}");
+  occa::json &defines = props["defines"];
+  const occa::hash_t propsHash = props.hash();
+  defines["B"] = 2;
+  OCCA_ASSERT_TRUE(propsHash != props.hash());
+  OCCA_ASSERT_TRUE(occa::properties("defines: {A: 1, B: 2}").hash() == props.hash());
+
+  occa::json &a = defines["A"];
+  const occa::hash_t propsHash2 = props.hash();
+  a = 3;
+  OCCA_ASSERT_TRUE(propsHash2 != props.hash());
+  OCCA_ASSERT_TRUE(occa::properties("defines: {A: 3, B: 2}").hash() == props.hash());
+}
+
+void testHashUpdate() {
+  std::string str;
+  for (int i = 0; i < 200; ++i) {
+    str += (char) ('a' + ((7 * i) % 26));
+  }
+  const int strSize = (int) str.size();
+  const occa::hash_t hash = occa::hash(str);
+
+  // hash(a + b) == hash(a).update(b), on and off the 32-byte stripes
+  const int splits[] = {0, 1, 7, 31, 32, 33, 63, 64, 65, 100, 199, 200};
+  const int splitCount = (int) (sizeof(splits) / sizeof(int));
+  for (int i = 0; i < splitCount; ++i) {
+    occa::hash_t splitHash = occa::hash(str.substr(0, splits[i]));
+    splitHash.update(str.substr(splits[i]));
+    OCCA_ASSERT_TRUE(hash == splitHash);
+  }
+
+  // Many small updates
+  for (int step = 1; step <= 33; step += 8) {
+    occa::hash_t splitHash = occa::hash(str.substr(0, step));
+    for (int i = step; i < strSize; i += step) {
+      splitHash.update(str.c_str() + i,
+                       (i + step < strSize) ? step : (strSize - i));
+    }
+    OCCA_ASSERT_TRUE(hash == splitHash);
+  }
+
+  OCCA_ASSERT_TRUE(hash != occa::hash(str.substr(1)));
+}
+
+void testCopies() {
+  occa::json a;
+  a.load("{x: {y: [1, {z: 2}]}, w: [1, 2]}");
+  const std::string aStr = a.toString();
+
+  // Writing nested values of a copy leaves the original untouched
+  occa::json b = a;
+  b["x"]["y"][1]["z"] = 3;
+  b["x"]["y"] += occa::json(4);
+  OCCA_ASSERT_EQUAL(aStr, a.toString());
+  OCCA_ASSERT_EQUAL(3, (int) b["x/y"][1]["z"]);
+  OCCA_ASSERT_EQUAL(3, b["x/y"].size());
+
+  // And the other way around
+  const std::string bStr = b.toString();
+  a["w"] += occa::json(3);
+  a["x"]["y"][0] = 5;
+  OCCA_ASSERT_EQUAL(bStr, b.toString());
+  OCCA_ASSERT_EQUAL(2, b["w"].size());
+  OCCA_ASSERT_EQUAL(1, (int) b["x/y"][0]);
+
+  // Copies of nested values
+  occa::json y = a["x/y"];
+  y[1]["z"] = 6;
+  y.array().pop_back();
+  OCCA_ASSERT_EQUAL(2, (int) a["x/y"][1]["z"]);
+  OCCA_ASSERT_EQUAL(2, a["x/y"].size());
+
+  // Assignment shares the same way
+  occa::json c;
+  c = a;
+  c["w"].array().clear();
+  OCCA_ASSERT_EQUAL(3, a["w"].size());
+  OCCA_ASSERT_EQUAL(0, c["w"].size());
+
+  // Self-assignment keeps the value
+  c = c;
+  OCCA_ASSERT_EQUAL(0, c["w"].size());
+  OCCA_ASSERT_EQUAL(5, (int) c["x/y"][0]);
+
+  // References handed out before a copy only write to the original
+  occa::json d;
+  d.load("{x: 1, n: {a: 1}}");
+  occa::json &x = d["x"];
+  occa::jsonObject &n = d["n"].object();
+  occa::json e = d;
+  x = 5;
+  n["a"] = 3;
+  OCCA_ASSERT_EQUAL(1, e.get<int>("x"));
+  OCCA_ASSERT_EQUAL(1, e.get<int>("n/a"));
+  OCCA_ASSERT_EQUAL(5, d.get<int>("x"));
+  OCCA_ASSERT_EQUAL(3, d.get<int>("n/a"));
+
+  occa::properties props("defines: {N: 1}");
+  occa::json &defines = props["defines"];
+  const occa::properties snapshot = props;
+  defines["N"] = 2;
+  OCCA_ASSERT_EQUAL(1, snapshot.get<int>("defines/N"));
+  OCCA_ASSERT_EQUAL(2, props.get<int>("defines/N"));
+}
+
+void testRoundTrip() {
+  // Plain integers skip primitive::load but must give the same value
+  const char *numbers[] = {
+    "0", "-0", "7", "-12345", "2147483647", "-2147483648",
+    "123456789012345678", "12345678901234567890",
+    "00", "010", "-010", "0x1F", "1.5", "-2e3", "10u", "10L"
+  };
+  const int numberCount = (int) (sizeof(numbers) / sizeof(const char*));
+  for (int i = 0; i < numberCount; ++i) {
+    const std::string number = numbers[i];
+    const occa::json j = occa::json::parse(number);
+    const occa::primitive p = occa::primitive::load(number);
+    OCCA_ASSERT_EQUAL(occa::json::number_, j.type);
+    OCCA_ASSERT_EQUAL(p.type, j.value_.number.type);
+    OCCA_ASSERT_EQUAL(p.toString(), j.value_.number.toString());
+  }
+
+  // Values and keys through the plain and escaped string paths
+  const std::string str = (
+    "{"
+    "  \"plain\": \"abc\","
+    "  \"esc\\\"aped\\n\": \"a\\\"b\\\\c\\/d\\b\\f\\n\\r\\te\","
+    "  \"unicode\": \"\\u0123x\\uABCD\","
+    "  \"key with: colon\": [1, -2, 010, 3.5, \"\", true, null],"
+    "  unquoted: {b: 1, a: [{}, []]},"
+    "}"
+  );
+  occa::json j;
+  j.load(str);
+  OCCA_ASSERT_EQUAL("abc", j["plain"].string());
+  OCCA_ASSERT_EQUAL("a\"b\\c/d\b\f\n\r\te", j["esc\"aped\n"].string());
+  OCCA_ASSERT_EQUAL("\\u0123x\\uABCD", j["unicode"].string());
+  OCCA_ASSERT_EQUAL(7, j["key with: colon"].size());
+  OCCA_ASSERT_EQUAL(-2, (int) j["key with: colon"][1]);
+  OCCA_ASSERT_EQUAL(8, (int) j["key with: colon"][2]);
+
+  for (int indent = 0; indent <= 2; indent += 2) {
+    occa::json j2;
+    j2.load(j.toString(indent));
+    OCCA_ASSERT_EQUAL(j.toString(), j2.toString());
+    OCCA_ASSERT_TRUE(j.hash() == j2.hash());
+  }
+}
+
+void testPropertyPaths() {
+  const occa::properties props("a: {b: {c: 1, d: 'x'}}, e: 2, f: [1, 2], g: 'h'");
+
+  // Pre-split paths match the string paths, including missing paths
+  //   and paths through non-objects
+  const char *paths[] = {
+    "a", "a/b", "a/b/c", "a/b/d", "e", "f", "g",
+    "z", "a/z", "a/b/z", "a/b/c/z", "e/z", "f/z", "g/z"
+  };
+  const int pathCount = (int) (sizeof(paths) / sizeof(const char*));
+  for (int i = 0; i < pathCount; ++i) {
+    const occa::properties::path path(paths[i]);
+    OCCA_ASSERT_EQUAL(props.has(paths[i]), props.has(path));
+    OCCA_ASSERT_EQUAL(props[paths[i]].toString(), props[path].toString());
+    OCCA_ASSERT_EQUAL(props.has(paths[i]), props.find(path) != NULL);
+  }
+
+  OCCA_ASSERT_EQUAL(props.get<int>("a/b/c"),
+                    props.get<int>(occa::properties::path("a/b/c")));
+  OCCA_ASSERT_EQUAL(props.get<std::string>("a/b/d"),
+                    props.get<std::string>(occa::properties::path("a/b/d")));
+  OCCA_ASSERT_EQUAL(props.get<int>("a/z", 3),
+                    props.get<int>(occa::properties::path("a/z"), 3));
+  OCCA_ASSERT_EQUAL(3, props.get<int>(occa::properties::path("e/z"), 3));
+
+  // Non-const operator [] creates the same objects
+  occa::properties p1 = props, p2 = props;
+  p1["a/y/x"] = 4;
+  p2[occa::properties::path("a/y/x")] = 4;
+  p1["a/b/c"] = 5;
+  p2[occa::properties::path("a/b/c")] = 5;
+  OCCA_ASSERT_EQUAL(p1.toString(), p2.toString());
+  OCCA_ASSERT_TRUE(p1.hash() == p2.hash());
+  OCCA_ASSERT_TRUE(props.hash() != p2.hash());
+}
@@ -0,0 +1,210 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2014-2018 David Medina and Tim Warburton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ */
+
+#include "occa.hpp"
+
+void testReuse();
+void testSplit();
+void testBestFit();
+void testCoalesce();
+void testLargeAllocations();
+void testTrim();
+
+occa::device newPoolDevice();
+char* ptrOf(occa::memory mem);
+
+int main(const int argc, const char **argv) {
+  testReuse();
+  testSplit();
+  testBestFit();
+  testCoalesce();
+  testLargeAllocations();
+  testTrim();
+  return 0;
+}
+
+occa::device newPoolDevice() {
+  return occa::device(
+    occa::properties(std::string("mode: 'Serial',"
+                                 "memory: {"
+                                 "  pool: true,"
+                                 "  pool-chunk-bytes: 4096,"
+                                 "}"))
+  );
+}
+
+char* ptrOf(occa::memory mem) {
+  return (char*) mem.ptr();
+}
+
+void testReuse() {
+  occa::device device = newPoolDevice();
+
+  occa::memory a = device.malloc(100);
+  char *aPtr = ptrOf(a);
+  a.free();
+
+  // Rounded up to the same block
+  occa::memory b = device.malloc(200);
+  OCCA_ASSERT_EQUAL(aPtr, ptrOf(b));
+
+  occa::memoryPoolStats stats = device.getMemoryPoolStats();
+  OCCA_ASSERT_EQUAL(stats.allocations, (occa::udim_t) 2);
+  OCCA_ASSERT_EQUAL(stats.reusedAllocations, (occa::udim_t) 1);
+  OCCA_ASSERT_EQUAL(stats.backendAllocations, (occa::udim_t) 1);
+  OCCA_ASSERT_EQUAL(stats.usedBytes, (occa::udim_t) 256);
+
+  b.free();
+  device.free();
+}
+
+void testSplit() {
+  occa::device device = newPoolDevice();
+
+  occa::memory a = device.malloc(256);
+  occa::memory b = device.malloc(256);
+  occa::memory c = device.malloc(1);
+
+  OCCA_ASSERT_EQUAL(ptrOf(a) + 256, ptrOf(b));
+  OCCA_ASSERT_EQUAL(ptrOf(b) + 256, ptrOf(c));
+
+  occa::memoryPoolStats stats = device.getMemoryPoolStats();
+  OCCA_ASSERT_EQUAL(stats.backendAllocations, (occa::udim_t) 1);
+  OCCA_ASSERT_EQUAL(stats.reservedBytes, (occa::udim_t) 4096);
+  OCCA_ASSERT_EQUAL(stats.usedBytes, (occa::udim_t) 768);
+
+  a.free();
+  b.free();
+  c.free();
+  device.free();
+}
+
+void testBestFit() {
+  occa::device device = newPoolDevice();
+
+  occa::memory a = device.malloc(256);
+  occa::memory b = device.malloc(512);
+  occa::memory c = device.malloc(256);
+  occa::memory d = device.malloc(1024);
+  occa::memory e = device.malloc(256);
+
+  char *bPtr = ptrOf(b);
+  char *dPtr = ptrOf(d);
+  b.free();
+  d.free();
+
+  // Picks the smallest free block that fits, not the first one
+  occa::memory f = device.malloc(600);
+  OCCA_ASSERT_EQUAL(dPtr, ptrOf(f));
+
+  occa::memory g = device.malloc(300);
+  OCCA_ASSERT_EQUAL(bPtr, ptrOf(g));
+
+  // The rest of d's block was split off and is reused
+  occa::memory h = device.malloc(256);
+  OCCA_ASSERT_EQUAL(dPtr + 768, ptrOf(h));
+
+  // Everything after the first allocation came from the one chunk
+  occa::memoryPoolStats stats = device.getMemoryPoolStats();
+  OCCA_ASSERT_EQUAL(stats.allocations, (occa::udim_t) 8);
+  OCCA_ASSERT_EQUAL(stats.reusedAllocations, (occa::udim_t) 7);
+  OCCA_ASSERT_EQUAL(stats.backendAllocations, (occa::udim_t) 1);
+
+  a.free();
+  c.free();
+  e.free();
+  f.free();
+  g.free();
+  h.free();
+  device.free();
+}
+
+void testCoalesce() {
+  occa::device device = newPoolDevice();
+
+  occa::memory a = device.malloc(1024);
+  occa::memory b = device.malloc(1024);
+  occa::memory c = device.malloc(1024);
+  char *aPtr = ptrOf(a);
+
+  // Freeing b last merges with both neighbors and the tail
+  a.free();
+  c.free();
+  b.free();
+
+  occa::memory d = device.malloc(4096);
+  OCCA_ASSERT_EQUAL(aPtr, ptrOf(d));
+
+  occa::memoryPoolStats stats = device.getMemoryPoolStats();
+  OCCA_ASSERT_EQUAL(stats.reusedAllocations, (occa::udim_t) 3);
+  OCCA_ASSERT_EQUAL(stats.backendAllocations, (occa::udim_t) 1);
+  OCCA_ASSERT_EQUAL(stats.usedBytes, (occa::udim_t) 4096);
+
+  d.free();
+  device.free();
+}
+
+void testLargeAllocations() {
+  occa::device device = newPoolDevice();
+
+  occa::memory a = device.malloc(10000);
+  occa::memory b = device.malloc(256);
+
+  occa::memoryPoolStats stats = device.getMemoryPoolStats();
+  OCCA_ASSERT_EQUAL(stats.backendAllocations, (occa::udim_t) 2);
+  OCCA_ASSERT_EQUAL(stats.reservedBytes, (occa::udim_t) (10240 + 4096));
+
+  a.free();
+  occa::memory c = device.malloc(8192);
+  OCCA_ASSERT_EQUAL(device.getMemoryPoolStats().backendAllocations,
+                    (occa::udim_t) 2);
+
+  b.free();
+  c.free();
+  device.free();
+}
+
+void testTrim() {
+  occa::device device = newPoolDevice();
+
+  occa::memory a = device.malloc(256);
+  occa::memory b = device.malloc(8192);
+  b.free();
+
+  // Only fully free chunks go back to the backend
+  device.trimMemoryPool();
+
+  occa::memoryPoolStats stats = device.getMemoryPoolStats();
+  OCCA_ASSERT_EQUAL(stats.backendFrees, (occa::udim_t) 1);
+  OCCA_ASSERT_EQUAL(stats.reservedBytes, (occa::udim_t) 4096);
+  OCCA_ASSERT_EQUAL(stats.peakReservedBytes, (occa::udim_t) (4096 + 8192));
+
+  a.free();
+  device.trimMemoryPool();
+
+  stats = device.getMemoryPoolStats();
+  OCCA_ASSERT_EQUAL(stats.backendFrees, (occa::udim_t) 2);
+  OCCA_ASSERT_EQUAL(stats.reservedBytes, (occa::udim_t) 0);
+  OCCA_ASSERT_EQUAL(stats.usedBytes, (occa::udim_t) 0);
+
+  device.free();
+}
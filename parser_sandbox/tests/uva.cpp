@@ -0,0 +1,138 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2014-2018 David Medina and Tim Warburton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ */
+
+#include "occa.hpp"
+
+void testFind();
+void testPendingUpdates();
+void testErase();
+void testEmptyRanges();
+
+occa::memory_v* fakeMemory(const int id);
+
+int main(const int argc, const char **argv) {
+  testFind();
+  testPendingUpdates();
+  testErase();
+  testEmptyRanges();
+  return 0;
+}
+
+// Entries are only compared, never dereferenced
+occa::memory_v* fakeMemory(const int id) {
+  return (occa::memory_v*) (size_t) (16 * id);
+}
+
+void testFind() {
+  char buffer[300];
+  occa::ptrRangeMap map;
+
+  // Inserted out of order
+  map.insert(occa::ptrRange(buffer + 200, 100), fakeMemory(3));
+  map.insert(occa::ptrRange(buffer      , 100), fakeMemory(1));
+  map.insert(occa::ptrRange(buffer + 100, 50) , fakeMemory(2));
+
+  OCCA_ASSERT_EQUAL(map.size(), (size_t) 3);
+
+  OCCA_ASSERT_EQUAL(map.find(buffer)      , fakeMemory(1));
+  OCCA_ASSERT_EQUAL(map.find(buffer + 99) , fakeMemory(1));
+  OCCA_ASSERT_EQUAL(map.find(buffer + 100), fakeMemory(2));
+  OCCA_ASSERT_EQUAL(map.find(buffer + 149), fakeMemory(2));
+  OCCA_ASSERT_EQUAL(map.find(buffer + 250), fakeMemory(3));
+
+  // Gaps and addresses outside every range
+  OCCA_ASSERT_TRUE(map.find(buffer + 150) == NULL);
+  OCCA_ASSERT_TRUE(map.find(buffer + 199) == NULL);
+  OCCA_ASSERT_TRUE(map.find(buffer + 300) == NULL);
+  OCCA_ASSERT_TRUE(map.find(buffer - 1) == NULL);
+}
+
+void testPendingUpdates() {
+  char buffer[400];
+  occa::ptrRangeMap map;
+
+  map.insert(occa::ptrRange(buffer + 100, 100), fakeMemory(2));
+  OCCA_ASSERT_EQUAL(map.find(buffer + 150), fakeMemory(2));
+
+  // Inserts around published entries are merged in order
+  map.insert(occa::ptrRange(buffer      , 100), fakeMemory(1));
+  map.insert(occa::ptrRange(buffer + 300, 100), fakeMemory(4));
+  map.insert(occa::ptrRange(buffer + 200, 100), fakeMemory(3));
+
+  OCCA_ASSERT_EQUAL(map.find(buffer + 50) , fakeMemory(1));
+  OCCA_ASSERT_EQUAL(map.find(buffer + 150), fakeMemory(2));
+  OCCA_ASSERT_EQUAL(map.find(buffer + 250), fakeMemory(3));
+  OCCA_ASSERT_EQUAL(map.find(buffer + 350), fakeMemory(4));
+  OCCA_ASSERT_EQUAL(map.size(), (size_t) 4);
+}
+
+void testErase() {
+  char buffer[300];
+  occa::ptrRangeMap map;
+
+  map.insert(occa::ptrRange(buffer      , 100), fakeMemory(1));
+  map.insert(occa::ptrRange(buffer + 100, 100), fakeMemory(2));
+  map.insert(occa::ptrRange(buffer + 200, 100), fakeMemory(3));
+  OCCA_ASSERT_EQUAL(map.size(), (size_t) 3);
+
+  // Erasing through any address in the range
+  map.erase(buffer + 150);
+  OCCA_ASSERT_TRUE(map.find(buffer + 100) == NULL);
+  OCCA_ASSERT_EQUAL(map.find(buffer + 50) , fakeMemory(1));
+  OCCA_ASSERT_EQUAL(map.find(buffer + 250), fakeMemory(3));
+  OCCA_ASSERT_EQUAL(map.size(), (size_t) 2);
+
+  // Erasing an insert that was never published
+  map.insert(occa::ptrRange(buffer + 100, 100), fakeMemory(4));
+  map.erase(buffer + 100);
+  OCCA_ASSERT_TRUE(map.find(buffer + 100) == NULL);
+
+  // Re-inserting a published range after erasing it
+  map.erase(buffer);
+  map.insert(occa::ptrRange(buffer, 100), fakeMemory(5));
+  OCCA_ASSERT_EQUAL(map.find(buffer + 10), fakeMemory(5));
+  OCCA_ASSERT_EQUAL(map.size(), (size_t) 2);
+
+  // Unknown addresses are ignored
+  map.erase(buffer + 150);
+  OCCA_ASSERT_EQUAL(map.size(), (size_t) 2);
+
+  map.erase(buffer);
+  map.erase(buffer + 200);
+  OCCA_ASSERT_EQUAL(map.size(), (size_t) 0);
+  OCCA_ASSERT_TRUE(map.find(buffer) == NULL);
+}
+
+void testEmptyRanges() {
+  char buffer[100];
+  occa::ptrRangeMap map;
+
+  map.insert(occa::ptrRange(buffer + 50, 0), fakeMemory(1));
+
+  // Only the start matches
+  OCCA_ASSERT_EQUAL(map.find(buffer + 50), fakeMemory(1));
+  OCCA_ASSERT_TRUE(map.find(buffer + 51) == NULL);
+  OCCA_ASSERT_TRUE(map.find(buffer + 49) == NULL);
+
+  map.erase(buffer + 50);
+  OCCA_ASSERT_TRUE(map.find(buffer + 50) == NULL);
+}
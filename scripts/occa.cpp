@@ -218,9 +218,12 @@ bool runClear(const occa::cli::command &command,
         }
       }
     } else if (it->first == "libraries") {
-      removedSomething |= removeDir(occa::io::libraryPath(), promptCheck);
+      // Includes libraries from older cache versions
+      const std::string librariesPath = occa::env::OCCA_CACHE_DIR + "libraries/";
+      removedSomething |= removeDir(librariesPath, promptCheck);
     } else if (it->first == "kernels") {
-      removedSomething |= removeDir(occa::io::cachePath(), promptCheck);
+      const std::string kernelsPath = occa::env::OCCA_CACHE_DIR + "cache/";
+      removedSomething |= removeDir(kernelsPath, promptCheck);
     } else if (it->first == "locks") {
       const std::string lockPath = occa::env::OCCA_CACHE_DIR + "locks/";
       removedSomething |= removeDir(lockPath, promptCheck);
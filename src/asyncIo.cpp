@@ -0,0 +1,417 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2014-2018 David Medina and Tim Warburton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <queue>
+#include <set>
+
+#include "occa/defines.hpp"
+
+#if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
+#  include <fcntl.h>
+#  include <pthread.h>
+#  include <unistd.h>
+#else
+#  include <cstdio>
+#endif
+
+#include "occa/asyncIo.hpp"
+#include "occa/device.hpp"
+#include "occa/tools/env.hpp"
+#include "occa/tools/io.hpp"
+#include "occa/tools/sys.hpp"
+
+namespace occa {
+  namespace io {
+    //---[ Requests ]-------------------
+    class asyncRequest {
+    public:
+      bool isRead;
+      std::string filename;
+
+      int fd, directFd;
+      udim_t fileOffset;
+      udim_t bytes;
+      udim_t chunkBytes;
+
+      // Host pointer used by the workers, either the memory itself
+      //   or [staging] for writes and memory in a separate memory space
+      // Reads keep [mem] to hold a reference until they are waited on
+      char *ptr;
+      char *staging;
+      occa::memory mem;
+
+      int pendingChunks;
+      int error;
+
+      asyncRequest() :
+        isRead(true),
+        fd(-1),
+        directFd(-1),
+        fileOffset(0),
+        bytes(0),
+        chunkBytes(0),
+        ptr(NULL),
+        staging(NULL),
+        pendingChunks(0),
+        error(0) {}
+    };
+
+    class asyncChunk {
+    public:
+      asyncRequest *request;
+      udim_t offset;
+      udim_t bytes;
+
+      asyncChunk(asyncRequest *request_,
+                 const udim_t offset_,
+                 const udim_t bytes_) :
+        request(request_),
+        offset(offset_),
+        bytes(bytes_) {}
+    };
+
+    static std::set<asyncRequest*> requests;
+    static std::queue<asyncChunk> chunkQueue;
+    //==================================
+
+#if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
+    static const udim_t directAlignment = 4096;
+    static int workerCount = 0;
+
+    static pthread_mutex_t queueMutex = PTHREAD_MUTEX_INITIALIZER;
+    static pthread_cond_t queueCond   = PTHREAD_COND_INITIALIZER;
+    static pthread_cond_t doneCond    = PTHREAD_COND_INITIALIZER;
+
+    static bool isAligned(const udim_t value) {
+      return ((value % directAlignment) == 0);
+    }
+
+    static void processChunk(const asyncChunk &chunk) {
+      asyncRequest &request = *(chunk.request);
+
+      char *ptr           = request.ptr + chunk.offset;
+      const off_t offset  = (off_t) (request.fileOffset + chunk.offset);
+
+      const bool useDirect = ((request.directFd >= 0) &&
+                              isAligned((udim_t) ptr) &&
+                              isAligned(offset) &&
+                              isAligned(chunk.bytes));
+      const int fd = (useDirect ? request.directFd : request.fd);
+
+      udim_t done = 0;
+      while (done < chunk.bytes) {
+        const ssize_t ret = (request.isRead
+                             ? ::pread(fd, ptr + done, chunk.bytes - done, offset + done)
+                             : ::pwrite(fd, ptr + done, chunk.bytes - done, offset + done));
+        if (ret < 0) {
+          if (errno == EINTR) {
+            continue;
+          }
+          request.error = errno;
+          return;
+        }
+        // Reading past the end of the file
+        if (ret == 0) {
+          request.error = EIO;
+          return;
+        }
+        done += ret;
+      }
+    }
+
+    static void* worker(void*) {
+      while (true) {
+        pthread_mutex_lock(&queueMutex);
+        while (chunkQueue.empty()) {
+          pthread_cond_wait(&queueCond, &queueMutex);
+        }
+        asyncChunk chunk = chunkQueue.front();
+        chunkQueue.pop();
+        pthread_mutex_unlock(&queueMutex);
+
+        processChunk(chunk);
+
+        pthread_mutex_lock(&queueMutex);
+        if (--(chunk.request->pendingChunks) == 0) {
+          pthread_cond_broadcast(&doneCond);
+        }
+        pthread_mutex_unlock(&queueMutex);
+      }
+      return NULL;
+    }
+
+    // Called with [queueMutex] locked
+    static void startWorkers() {
+      if (workerCount) {
+        return;
+      }
+      workerCount = env::get<int>("OCCA_IO_THREADS", 4);
+      OCCA_ERROR("OCCA_IO_THREADS must be positive",
+                 workerCount > 0);
+
+      for (int t = 0; t < workerCount; ++t) {
+        pthread_t tid;
+        pthread_create(&tid, NULL, worker, NULL);
+        pthread_detach(tid);
+      }
+    }
+
+    static bool openFiles(asyncRequest &request,
+                          const bool useDirect) {
+      const int flags = (request.isRead
+                         ? O_RDONLY
+                         : (O_WRONLY | O_CREAT));
+
+      request.fd = ::open(request.filename.c_str(), flags, 0644);
+      if (request.fd < 0) {
+        return false;
+      }
+
+#  ifdef O_DIRECT
+      if (useDirect) {
+        request.directFd = ::open(request.filename.c_str(), flags | O_DIRECT, 0644);
+        OCCA_WARNING("Unable to open [" << io::shortname(request.filename) << "]"
+                     << " with O_DIRECT, using buffered I/O",
+                     request.directFd >= 0);
+      }
+#  endif
+      return true;
+    }
+
+    static void closeFiles(asyncRequest &request) {
+      if (request.fd >= 0) {
+        ::close(request.fd);
+      }
+      if (request.directFd >= 0) {
+        ::close(request.directFd);
+      }
+    }
+#else
+    static bool openFiles(asyncRequest &request,
+                          const bool useDirect) {
+      return true;
+    }
+
+    static void closeFiles(asyncRequest &request) {}
+#endif
+
+    static void freeRequest(asyncRequest *request) {
+      closeFiles(*request);
+      if (request->staging) {
+        sys::free(request->staging);
+      }
+      delete request;
+    }
+
+    static streamTag submit(asyncRequest *request) {
+#if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
+      const udim_t chunkBytes = request->chunkBytes;
+
+      pthread_mutex_lock(&queueMutex);
+      startWorkers();
+
+      requests.insert(request);
+      for (udim_t offset = 0; offset < request->bytes; offset += chunkBytes) {
+        const udim_t bytes = std::min(chunkBytes, request->bytes - offset);
+        chunkQueue.push(asyncChunk(request, offset, bytes));
+        ++(request->pendingChunks);
+      }
+
+      pthread_cond_broadcast(&queueCond);
+      pthread_mutex_unlock(&queueMutex);
+#else
+      FILE *fp = fopen(request->filename.c_str(), request->isRead ? "rb" : "r+b");
+      if ((fp == NULL) && !request->isRead) {
+        fp = fopen(request->filename.c_str(), "wb");
+      }
+      if (fp == NULL) {
+        const std::string filename = request->filename;
+        freeRequest(request);
+        OCCA_FORCE_ERROR("Failed to open [" << io::shortname(filename) << "]");
+      }
+
+      fseek(fp, request->fileOffset, SEEK_SET);
+      const size_t done = (request->isRead
+                           ? fread(request->ptr, sizeof(char), request->bytes, fp)
+                           : fwrite(request->ptr, sizeof(char), request->bytes, fp));
+      fclose(fp);
+
+      if (done != request->bytes) {
+        request->error = EIO;
+      }
+      requests.insert(request);
+#endif
+
+      return streamTag(sys::currentTime(), request);
+    }
+
+    static asyncRequest* newRequest(const bool isRead,
+                                    occa::memory mem,
+                                    const std::string &filename,
+                                    const dim_t bytes,
+                                    const dim_t offset,
+                                    const occa::properties &props) {
+      OCCA_ERROR("Memory not initialized",
+                 mem.isInitialized());
+
+      const udim_t bytes_ = ((bytes == -1) ? mem.size() : bytes);
+      OCCA_ERROR("Trying to " << (isRead ? "read " : "write ")
+                 << bytes_ << " bytes with memory of size " << mem.size(),
+                 bytes_ <= mem.size());
+      OCCA_ERROR("Negative file offset (" << offset << ")",
+                 offset >= 0);
+
+      const dim_t chunkBytes = props.get<dim_t>("chunk-bytes", 8 << 20);
+      OCCA_ERROR("[chunk-bytes] must be positive",
+                 chunkBytes > 0);
+
+      asyncRequest *request = new asyncRequest();
+      request->isRead     = isRead;
+      request->filename   = filename;
+      request->fileOffset = offset;
+      request->bytes      = bytes_;
+      request->chunkBytes = chunkBytes;
+
+      // Open files before staging or copying anything
+      if (!openFiles(*request, props.get("direct", false))) {
+        freeRequest(request);
+        OCCA_FORCE_ERROR("Failed to open [" << io::shortname(filename) << "]");
+      }
+
+      // Writes snapshot the memory so it can be modified or freed
+      //   before the request completes
+      if (!isRead || mem.getDHandle()->hasSeparateMemorySpace()) {
+        request->staging = (char*) sys::malloc(bytes_);
+        request->ptr     = request->staging;
+      } else {
+        request->ptr = (char*) mem.ptr();
+      }
+      if (isRead) {
+        request->mem = mem;
+      }
+      return request;
+    }
+
+    streamTag readAsync(occa::memory mem,
+                        const std::string &filename,
+                        const dim_t bytes,
+                        const dim_t offset,
+                        const occa::properties &props) {
+
+      asyncRequest *request = newRequest(true, mem, filename, bytes, offset, props);
+      return submit(request);
+    }
+
+    streamTag writeAsync(const std::string &filename,
+                         const occa::memory mem,
+                         const dim_t bytes,
+                         const dim_t offset,
+                         const occa::properties &props) {
+
+      asyncRequest *request = newRequest(false, mem, filename, bytes, offset, props);
+      mem.copyTo(request->staging, request->bytes);
+      return submit(request);
+    }
+
+    bool isAsyncTag(const streamTag &tag) {
+#if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
+      pthread_mutex_lock(&queueMutex);
+      const bool ret = (requests.find((asyncRequest*) tag.handle) != requests.end());
+      pthread_mutex_unlock(&queueMutex);
+      return ret;
+#else
+      return (requests.find((asyncRequest*) tag.handle) != requests.end());
+#endif
+    }
+
+    bool isDone(const streamTag &tag) {
+      if (!isAsyncTag(tag)) {
+        return true;
+      }
+      asyncRequest *request = (asyncRequest*) tag.handle;
+#if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
+      pthread_mutex_lock(&queueMutex);
+      const bool ret = (request->pendingChunks == 0);
+      pthread_mutex_unlock(&queueMutex);
+      return ret;
+#else
+      return (request->pendingChunks == 0);
+#endif
+    }
+
+    void waitFor(const streamTag &tag) {
+      asyncRequest *request = (asyncRequest*) tag.handle;
+
+#if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
+      pthread_mutex_lock(&queueMutex);
+      if (requests.find(request) == requests.end()) {
+        pthread_mutex_unlock(&queueMutex);
+        return;
+      }
+      while (request->pendingChunks) {
+        pthread_cond_wait(&doneCond, &queueMutex);
+      }
+      requests.erase(request);
+      pthread_mutex_unlock(&queueMutex);
+#else
+      if (requests.find(request) == requests.end()) {
+        return;
+      }
+      requests.erase(request);
+#endif
+
+      const int error = request->error;
+      const std::string filename = request->filename;
+      const bool isRead = request->isRead;
+
+      if (!error && isRead && request->staging) {
+        request->mem.copyFrom(request->staging, request->bytes);
+      }
+      freeRequest(request);
+
+      OCCA_ERROR("Failed to " << (isRead ? "read from" : "write to")
+                 << " [" << io::shortname(filename) << "]: "
+                 << ::strerror(error),
+                 error == 0);
+    }
+
+    void finish() {
+      while (true) {
+#if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
+        pthread_mutex_lock(&queueMutex);
+#endif
+        const bool isEmpty = requests.empty();
+        asyncRequest *request = (isEmpty ? NULL : *(requests.begin()));
+#if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
+        pthread_mutex_unlock(&queueMutex);
+#endif
+        if (isEmpty) {
+          return;
+        }
+        waitFor(streamTag(0, request));
+      }
+    }
+  }
+}
@@ -144,11 +144,8 @@ namespace occa {
               const dim_t bytes,
               const occa::properties &props) {
 
-    ptrRangeMap::iterator srcIt  = uvaMap.find(const_cast<void*>(src));
-    ptrRangeMap::iterator destIt = uvaMap.find(dest);
-
-    occa::memory_v *srcMem  = ((srcIt  != uvaMap.end()) ? (srcIt->second)  : NULL);
-    occa::memory_v *destMem = ((destIt != uvaMap.end()) ? (destIt->second) : NULL);
+    occa::memory_v *srcMem  = uvaMap.find(src);
+    occa::memory_v *destMem = uvaMap.find(dest);
 
     const udim_t srcOff  = (srcMem  ? (((char*) src)  - srcMem->uvaPtr)  : 0);
     const udim_t destOff = (destMem ? (((char*) dest) - destMem->uvaPtr) : 0);
@@ -158,6 +155,23 @@ namespace occa {
     const bool usingDestPtr = ((destMem  == NULL) ||
                                ((destMem->isManaged() && !destMem->inDevice())));
 
+    // Memory tracking dirty ranges stays in the device after syncs,
+    //   host writes to it still have to reach the device copy
+    if (!usingSrcPtr &&
+        srcMem->isManaged() &&
+        srcMem->tracksDirty()) {
+      srcMem->syncDirtyToDevice(srcOff, srcOff + bytes);
+    }
+    // The copied range overwrites its dirty host writes, the rest
+    //   reach the device before the host mirror is refreshed
+    if (!usingDestPtr &&
+        destMem->isManaged() &&
+        destMem->tracksDirty()) {
+      dirtyRanges::rangeVector overwritten;
+      destMem->dirty.remove(destOff, destOff + bytes, overwritten);
+      destMem->syncDirtyToDevice(0, destMem->size);
+    }
+
     if (usingSrcPtr && usingDestPtr) {
       ::memcpy(dest, src, bytes);
     } else if (usingSrcPtr) {
@@ -170,6 +184,11 @@ namespace occa {
       occa::memory destMemory(destMem);
       destMemory.copyFrom(srcMemory, bytes, destOff, srcOff, props);
     }
+
+    // Copies into the device copy leave the host mirror stale
+    if (!usingDestPtr && destMem->isManaged()) {
+      addToStaleMap(destMem);
+    }
   }
 
   void memcpy(memory dest, const void *src,
@@ -216,6 +235,24 @@ namespace occa {
               const occa::properties &props) {
     memcpy(dest, src, -1, 0, 0, props);
   }
+
+  void memcpy(memoryView dest, const void *src,
+              const dim_t bytes,
+              const occa::properties &props) {
+    dest.copyFrom(src, bytes, 0, props);
+  }
+
+  void memcpy(void *dest, memoryView src,
+              const dim_t bytes,
+              const occa::properties &props) {
+    src.copyTo(dest, bytes, 0, props);
+  }
+
+  void memcpy(memoryView dest, memoryView src,
+              const dim_t bytes,
+              const occa::properties &props) {
+    dest.copyFrom(src, bytes, 0, 0, props);
+  }
   //====================================
 
   //---[ Free Functions ]---------------
@@ -85,6 +85,13 @@ void OCCA_RFUNC occaMemorySyncToHost(occaMemory memory,
 
   occa::c::memory(memory).syncToHost(bytes, offset);
 }
+
+void OCCA_RFUNC occaMemoryMarkDirty(occaMemory memory,
+                                    const occaDim_t bytes,
+                                    const occaDim_t offset) {
+
+  occa::c::memory(memory).markDirty(offset, bytes);
+}
 //======================================
 
 void OCCA_RFUNC occaMemcpy(void *dest, const void *src,
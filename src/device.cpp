@@ -20,11 +20,15 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
  */
 
+#include <algorithm>
+
 #include "occa/device.hpp"
+#include "occa/asyncIo.hpp"
 #include "occa/base.hpp"
 #include "occa/mode.hpp"
 #include "occa/tools/sys.hpp"
 #include "occa/tools/io.hpp"
+#include "occa/tools/trace.hpp"
 #include "occa/parser/parser.hpp"
 
 namespace occa {
@@ -34,7 +38,10 @@ namespace occa {
     properties = properties_;
 
     currentStream = NULL;
-    bytesAllocated = 0;
+
+    allocations.setName(mode);
+    kernelStats.setup(this,
+                      properties.get("kernel-stats-sampling", 16));
   }
 
   device_v::~device_v() {}
@@ -71,6 +78,98 @@ namespace occa {
       cachedKernels.erase(it);
     }
   }
+
+  memoryPool& device_v::getMemoryPool(const occa::properties &props) {
+    // Key on the hashes of the top-level entries, skipping per-allocation
+    //   labels that don't change how chunks are allocated
+    std::string key;
+    const jsonObject &obj = props.object();
+    cJsonObjectIterator it = obj.begin();
+    while (it != obj.end()) {
+      if ((it->first != "pool") &&
+          (it->first != "tag")) {
+        const hash_t valueHash = it->second.hash();
+        key += it->first;
+        key += '\0';
+        key.append((const char*) valueHash.h, sizeof(valueHash.h));
+      }
+      ++it;
+    }
+
+    memoryPool *&pool = pools[occa::hash(key)];
+    if (pool == NULL) {
+      occa::properties chunkProps = props;
+      chunkProps.remove("pool");
+      chunkProps.remove("tag");
+      pool = new memoryPool(this, chunkProps);
+    }
+    return *pool;
+  }
+
+  memoryPool* device_v::findMemoryPool(memory_v *mem) {
+    memoryPoolMapIterator it = pools.begin();
+    while (it != pools.end()) {
+      if (it->second->owns(mem)) {
+        return it->second;
+      }
+      ++it;
+    }
+    return NULL;
+  }
+
+  void device_v::freeMemoryPools() {
+    memoryPoolMapIterator it = pools.begin();
+    while (it != pools.end()) {
+      delete it->second;
+      ++it;
+    }
+    pools.clear();
+  }
+
+  memory_v* device_v::mmap(const std::string &filename,
+                           const udim_t offset,
+                           const udim_t bytes,
+                           const occa::properties &props) {
+    // The allocation is a copy, only private mappings can be honored
+    const std::string mapping = props.get<std::string>("mapping", "private");
+    OCCA_ERROR("[" << mode << "] only supports private file mappings,"
+               << " not [" << mapping << "]",
+               mapping == "private");
+
+    FILE *fp = fopen(filename.c_str(), "rb");
+    OCCA_ERROR("Failed to open [" << io::shortname(filename) << "]",
+               fp != NULL);
+    fseek(fp, offset, SEEK_SET);
+
+    memory_v *mem = malloc(bytes, NULL, props);
+
+    // Stage through a bounded buffer to avoid holding the file twice
+    const udim_t chunkBytes = std::min(bytes, (udim_t) (64 << 20));
+    char *buffer = (char*) sys::malloc(chunkBytes);
+
+    for (udim_t copied = 0; copied < bytes; copied += chunkBytes) {
+      const udim_t copyBytes = std::min(chunkBytes, bytes - copied);
+      const size_t nread = fread(buffer, sizeof(char), copyBytes, fp);
+
+      OCCA_ERROR("Failed to read [" << io::shortname(filename) << "]",
+                 nread == copyBytes);
+      // Synchronous since [buffer] is reused for the next chunk
+      mem->copyFrom(buffer, copyBytes, copied);
+    }
+
+    sys::free(buffer);
+    fclose(fp);
+
+    return mem;
+  }
+
+  void device_v::freeStreamTag(const streamTag&) const {}
+
+  void device_v::startNestedLaunches() {}
+
+  void device_v::finishNestedLaunches() {}
+
+  void device_v::cancelNestedLaunches() {}
   //====================================
 
   //---[ device ]-----------------------
@@ -180,6 +279,12 @@ namespace occa {
       dHandle_->freeStream(dHandle_->streams[i]);
     }
     dHandle_->streams.clear();
+
+    dHandle_->freeMemoryPools();
+
+    // Timings need the device's stream tags
+    dHandle_->kernelStats.resolvePending();
+
     dHandle_->free();
   }
 
@@ -225,7 +330,41 @@ namespace occa {
   }
 
   udim_t device::memoryAllocated() const {
-    return dHandle->bytesAllocated;
+    return dHandle->allocations.getStats().bytes;
+  }
+
+  memoryStats device::getMemoryStats() const {
+    return dHandle->allocations.getStats();
+  }
+
+  void device::resetMemoryPeaks() {
+    dHandle->allocations.resetPeaks();
+  }
+
+  std::string device::liveMemoryReport() const {
+    return dHandle->allocations.liveReport();
+  }
+
+  memoryPoolStats device::getMemoryPoolStats() const {
+    memoryPoolStats stats;
+    cMemoryPoolMapIterator it = dHandle->pools.begin();
+    while (it != dHandle->pools.end()) {
+      stats += it->second->getStats();
+      ++it;
+    }
+    return stats;
+  }
+
+  void device::trimMemoryPool() {
+    memoryPoolMapIterator it = dHandle->pools.begin();
+    while (it != dHandle->pools.end()) {
+      it->second->trim();
+      ++it;
+    }
+  }
+
+  const kernelLaunchStatsMap& device::kernelStats() {
+    return dHandle->kernelStats.getStats();
   }
 
   void device::finish() {
@@ -235,9 +374,13 @@ namespace occa {
         occa::memory_v *mem = uvaStaleMemory[i];
 
         mem->copyTo(mem->uvaPtr, mem->size, 0, "async: true");
+        mem->dirty.clear();
 
-        mem->memInfo &= ~uvaFlag::inDevice;
+        if (!mem->tracksDirty()) {
+          mem->memInfo &= ~uvaFlag::inDevice;
+        }
         mem->memInfo &= ~uvaFlag::isStale;
+        mem->staleIndex = -1;
       }
       if (staleEntries) {
         uvaStaleMemory.clear();
@@ -245,6 +388,7 @@ namespace occa {
     }
 
     dHandle->finish();
+    dHandle->kernelStats.resolvePending();
   }
 
   bool device::hasSeparateMemorySpace() {
@@ -292,7 +436,11 @@ namespace occa {
   }
 
   void device::waitFor(streamTag tag) {
-    dHandle->waitFor(tag);
+    if (io::isAsyncTag(tag)) {
+      io::waitFor(tag);
+    } else {
+      dHandle->waitFor(tag);
+    }
   }
 
   double device::timeBetween(const streamTag &startTag, const streamTag &endTag) {
@@ -377,12 +525,24 @@ namespace occa {
                              const std::string &kernelName,
                              const occa::properties &props) const {
 
+    trace::scope traceScope("build", "buildKernel");
+    traceScope.addArg("kernel", kernelName);
+
+    // Memoized hashes are copied with the merged values, leaving
+    //   only the top level of allProps to hash
+    props.hash();
+    kernelProperties().hash();
+
     occa::properties allProps = props + kernelProperties();
     allProps["mode"] = mode();
 
-    hash_t kernelHash = (hash()
-                         ^ occa::hash(allProps)
-                         ^ hashFile(filename));
+    hash_t kernelHash;
+    {
+      trace::scope hashScope("build", "hash");
+      kernelHash = (hash()
+                    ^ occa::hash(allProps)
+                    ^ hashFile(filename));
+    }
 
     const std::string realFilename = io::filename(filename);
     const std::string hashDir = io::hashDir(realFilename, kernelHash);
@@ -392,6 +552,7 @@ namespace occa {
     if (allProps.get("okl", true)) {
       sourceFilename = hashDir + kc::parsedSourceFile;
 
+      trace::scope parseScope("build", "parse");
       kernelMetadataMap metadataMap = io::parseFile(realFilename,
                                                     sourceFilename,
                                                     allProps);
@@ -419,6 +580,11 @@ namespace occa {
                                        const std::string &kernelName,
                                        const occa::properties &props) const {
 
+    // Memoized hashes are copied with the merged values, leaving
+    //   only the top level of allProps to hash
+    props.hash();
+    kernelProperties().hash();
+
     occa::properties allProps = props + kernelProperties();
     allProps["mode"] = mode();
 
@@ -525,10 +691,12 @@ namespace occa {
 
     occa::properties memProps = props + memoryProperties();
 
-    memory mem(dHandle->malloc(bytes, src, memProps));
+    memory mem(memProps.get("pool", false)
+               ? dHandle->getMemoryPool(memProps).malloc(bytes, src, memProps)
+               : dHandle->malloc(bytes, src, memProps));
     mem.setDHandle(dHandle);
 
-    dHandle->bytesAllocated += bytes;
+    dHandle->allocations.add(mem.mHandle, bytes, memProps.get<std::string>("tag"));
 
     return mem;
   }
@@ -590,6 +758,47 @@ namespace occa {
 
     return umalloc(bytes, NULL, props);
   }
+
+  memory device::mmap(const std::string &filename,
+                      const dim_t offset,
+                      const dim_t bytes,
+                      const occa::properties &props) {
+
+    const dim_t fileBytes = io::fileSize(filename);
+    const dim_t bytes_    = ((bytes == -1) ? (fileBytes - offset) : bytes);
+
+    OCCA_ERROR("Trying to map "
+               << (bytes_ ? "negative" : "zero") << " bytes (" << bytes_ << ")",
+               bytes_ > 0);
+    OCCA_ERROR("Trying to map past the end of [" << io::shortname(filename) << "]",
+               (0 <= offset) && ((offset + bytes_) <= fileBytes));
+
+    occa::properties memProps = props + memoryProperties();
+
+    memory mem(dHandle->mmap(filename, offset, bytes_, memProps));
+    mem.setDHandle(dHandle);
+
+    dHandle->allocations.add(mem.mHandle, bytes_, memProps.get<std::string>("tag"));
+
+    return mem;
+  }
+
+  void* device::ummap(const std::string &filename,
+                      const dim_t offset,
+                      const dim_t bytes,
+                      const occa::properties &props) {
+
+    occa::properties memProps = props + memoryProperties();
+
+    memory mem = mmap(filename, offset, bytes, memProps);
+    mem.dontUseRefs();
+    mem.setupUva();
+
+    if (memProps.get("managed", true)) {
+      mem.startManaging();
+    }
+    return mem.getMHandle()->uvaPtr;
+  }
   //  |=================================
 
   template <>
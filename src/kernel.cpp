@@ -26,6 +26,7 @@
 #include "occa/uva.hpp"
 #include "occa/tools/io.hpp"
 #include "occa/tools/sys.hpp"
+#include "occa/tools/trace.hpp"
 
 namespace occa {
   //---[ KernelArg ]--------------------
@@ -164,10 +165,7 @@ namespace occa {
     if (argIsUva) {
       mHandle = (memory_v*) arg;
     } else if (lookAtUva) {
-      ptrRangeMap::iterator it = uvaMap.find(arg);
-      if (it != uvaMap.end()) {
-        mHandle = it->second;
-      }
+      mHandle = uvaMap.find(arg);
     }
 
     if (mHandle) {
@@ -192,11 +190,13 @@ namespace occa {
 
         if (!mHandle->inDevice()) {
           mHandle->copyFrom(mHandle->uvaPtr, mHandle->size);
+          mHandle->dirty.clear();
           mHandle->memInfo |= uvaFlag::inDevice;
+        } else if (!mHandle->dirty.isEmpty()) {
+          mHandle->syncDirtyToDevice(0, mHandle->size);
         }
-        if (!isConst && !mHandle->isStale()) {
-          uvaStaleMemory.push_back(mHandle);
-          mHandle->memInfo |= uvaFlag::isStale;
+        if (!isConst) {
+          addToStaleMap(mHandle);
         }
       }
     }
@@ -267,6 +267,7 @@ namespace occa {
   //---[ kernel_v ]---------------------
   kernel_v::kernel_v(const occa::properties &properties_) {
     dHandle = NULL;
+    launchStats = NULL;
 
     properties = properties_;
 
@@ -276,6 +277,10 @@ namespace occa {
 
   kernel_v::~kernel_v() {}
 
+  bool kernel_v::isBatched() const {
+    return false;
+  }
+
   // This should only be called in the very first reference
   void kernel_v::setDHandle(device_v *dHandle_) {
     dHandle = dHandle_;
@@ -435,26 +440,90 @@ namespace occa {
     kHandle->arguments.insert(kHandle->arguments.begin() + argPos, arg);
   }
 
+  namespace {
+    // Passes the nested kernels to a launch kernel, undoing the setup
+    //   if the launch throws before finish()
+    class nestedLaunchScope {
+    private:
+      kernel_v *kHandle;
+      device_v *dHandle;
+
+    public:
+      nestedLaunchScope(kernel_v *kHandle_) :
+        kHandle(kHandle_),
+        dHandle(NULL) {
+        if (!kHandle->nestedKernelCount()) {
+          return;
+        }
+        kHandle->arguments.insert(kHandle->arguments.begin(),
+                                  kHandle->nestedKernelsPtr());
+
+        dHandle = kHandle->nestedKernels[0].getKHandle()->dHandle;
+        dHandle->startNestedLaunches();
+      }
+
+      ~nestedLaunchScope() {
+        if (dHandle) {
+          dHandle->cancelNestedLaunches();
+          kHandle->arguments.erase(kHandle->arguments.begin());
+        }
+      }
+
+      void finish() {
+        if (!dHandle) {
+          return;
+        }
+        device_v *dHandle_ = dHandle;
+        dHandle = NULL;
+        kHandle->arguments.erase(kHandle->arguments.begin());
+        dHandle_->finishNestedLaunches();
+      }
+    };
+  }
+
   void kernel::runFromArguments() const {
+    trace::scope traceScope("launch", kHandle->name);
+    traceScope.addArg("mode", kHandle->dHandle->mode);
+
+    // Batched launches run inside their launcher's span and stats
+    const bool isBatched = kHandle->isBatched();
+    if (isBatched) {
+      traceScope.addArg("batched", 1);
+    }
+
+    udim_t argumentBytes = 0;
     const int argc = (int) kHandle->arguments.size();
     for (int i = 0; i < argc; ++i) {
+      const kernelArg &arg = kHandle->arguments[i];
       const bool argIsConst = kHandle->metadata.argIsConst(i);
-      kHandle->arguments[i].setupForKernelCall(argIsConst);
-    }
+      arg.setupForKernelCall(argIsConst);
 
-    // Add nestedKernels
-    const bool hasNestedKernels = kHandle->nestedKernelCount();
-    if (hasNestedKernels) {
-      kHandle->arguments.insert(kHandle->arguments.begin(),
-                                kHandle->nestedKernelsPtr());
+      const int argCount = (int) arg.args.size();
+      for (int j = 0; j < argCount; ++j) {
+        if (arg.args[j].mHandle) {
+          argumentBytes += arg.args[j].mHandle->size;
+        }
+      }
     }
 
+    kernelStatsRegistry &kernelStats = kHandle->dHandle->kernelStats;
+    kernelLaunchTag launchTag;
+    streamTag startTag;
+    const bool finishesLaunch = kernelStats.startLaunch(kHandle,
+                                                        argumentBytes,
+                                                        isBatched,
+                                                        launchTag,
+                                                        startTag);
+
+    nestedLaunchScope nestedScope(kHandle);
+
     kHandle->runFromArguments(kHandle->argumentCount(),
                               kHandle->argumentsPtr());
 
-    // Remove nestedKernels
-    if (hasNestedKernels) {
-      kHandle->arguments.erase(kHandle->arguments.begin());
+    nestedScope.finish();
+
+    if (finishesLaunch) {
+      kernelStats.finishLaunch(kHandle, launchTag, startTag);
     }
   }
 
@@ -462,6 +531,10 @@ namespace occa {
     kHandle->arguments.clear();
   }
 
+  kernelLaunchStats kernel::stats() {
+    return kHandle->dHandle->kernelStats.getStats(kHandle);
+  }
+
 #include "operators/definitions.cpp"
 
   void kernel::free() {
@@ -534,6 +607,10 @@ namespace occa {
 
   occa::kernel kernelBuilder::build(occa::device device,
                                     const occa::properties &props) {
+    // Reuse memoized hashes in kernelProps, see device::buildKernel
+    props_.hash();
+    props.hash();
+
     occa::properties kernelProps = props_;
     kernelProps += props;
     return build(device,
@@ -0,0 +1,301 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2014-2018 David Medina and Tim Warburton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ */
+
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+
+#include "occa/kernelStats.hpp"
+#include "occa/device.hpp"
+#include "occa/kernel.hpp"
+
+namespace occa {
+  //---[ kernelLaunchStats ]------------
+  const int kernelLaunchStats::recentTimeCount;
+
+  kernelLaunchStats::kernelLaunchStats() :
+    launches(0),
+    batchedLaunches(0),
+    argumentBytes(0),
+    timedLaunches(0),
+    totalTime(0),
+    minTime(0),
+    maxTime(0),
+    countedLaunches(0) {}
+
+  void kernelLaunchStats::addTime(const double time) {
+    if (!timedLaunches || (time < minTime)) {
+      minTime = time;
+    }
+    if (!timedLaunches || (maxTime < time)) {
+      maxTime = time;
+    }
+    totalTime += time;
+
+    // Ring buffer of the latest times
+    if ((int) recentTimes.size() < recentTimeCount) {
+      recentTimes.push_back(time);
+    } else {
+      recentTimes[timedLaunches % recentTimeCount] = time;
+    }
+    ++timedLaunches;
+  }
+
+  double kernelLaunchStats::meanTime() const {
+    return (timedLaunches
+            ? (totalTime / timedLaunches)
+            : 0);
+  }
+
+  double kernelLaunchStats::p99Time() const {
+    if (recentTimes.size() == 0) {
+      return 0;
+    }
+    std::vector<double> times = recentTimes;
+    const size_t index = (99 * (times.size() - 1)) / 100;
+    std::nth_element(times.begin(), times.begin() + index, times.end());
+    return times[index];
+  }
+
+  static std::string timeToString(const double time) {
+    std::stringstream ss;
+    if (time < 1e-3) {
+      ss << (1e6 * time) << " us";
+    } else if (time < 1) {
+      ss << (1e3 * time) << " ms";
+    } else {
+      ss << time << " s";
+    }
+    return ss.str();
+  }
+
+  std::string kernelLaunchStats::toString() const {
+    std::stringstream ss;
+    ss << name << " (" << hash << "): "
+       << launches << " launches, ";
+    if (batchedLaunches) {
+      ss << batchedLaunches << " batched, ";
+    }
+    ss << (argumentBytes ? stringifyBytes(argumentBytes) : "0 bytes")
+       << " in memory arguments";
+    if (timedLaunches) {
+      ss << "\n  " << timedLaunches << " timed:"
+         << " total " << timeToString(totalTime)
+         << ", min "  << timeToString(minTime)
+         << ", mean " << timeToString(meanTime())
+         << ", p99 "  << timeToString(p99Time())
+         << ", max "  << timeToString(maxTime);
+    }
+    if (countedLaunches) {
+      ss << "\n  " << countedLaunches << " counted:";
+      const char *separator = " ";
+      if (counters.has(perfCounter::cycles)) {
+        ss << separator << "cycles " << counters.cycles;
+        separator = ", ";
+      }
+      if (counters.has(perfCounter::instructions)) {
+        ss << separator << "instructions " << counters.instructions;
+        separator = ", ";
+      }
+      if (counters.has(perfCounter::cycles | perfCounter::instructions) &&
+          counters.cycles) {
+        ss << ", IPC " << ((double) counters.instructions / (double) counters.cycles);
+      }
+      if (counters.has(perfCounter::llcMisses)) {
+        ss << separator << "LLC misses " << counters.llcMisses;
+        separator = ", ";
+      }
+      if (counters.has(perfCounter::memoryBytes)) {
+        ss << separator << "memory " << stringifyBytes(counters.memoryBytes);
+        if (counters.has(perfCounter::instructions) &&
+            counters.instructions) {
+          ss << ", bytes/instruction "
+             << ((double) counters.memoryBytes / (double) counters.instructions);
+        }
+      }
+    }
+    ss << '\n';
+    return ss.str();
+  }
+
+  kernelLaunchTag::kernelLaunchTag() :
+    isTimed(false),
+    isCounted(false) {}
+  //====================================
+
+  //---[ kernelStatsRegistry ]----------
+  class kernelStatsRegistry::pendingLaunch {
+  public:
+    kernelLaunchStats *stats;
+    streamTag startTag, endTag;
+  };
+
+  // Pending launches are resolved in batches of this size
+  static const int maxPendingLaunches = 64;
+
+  kernelStatsRegistry::kernelStatsRegistry() :
+    dHandle(NULL),
+    sampling(0),
+    counters(NULL) {
+    exitReport::get("OCCA_KERNEL_REPORT").add(this);
+  }
+
+  kernelStatsRegistry::~kernelStatsRegistry() {
+    exitReport::get("OCCA_KERNEL_REPORT").remove(this);
+
+    // Devices resolve pending launches before being freed
+    const int pendingCount = (int) pendingLaunches.size();
+    for (int i = 0; i < pendingCount; ++i) {
+      delete pendingLaunches[i];
+    }
+    delete counters;
+  }
+
+  void kernelStatsRegistry::setup(device_v *dHandle_,
+                                  const int sampling_) {
+    OCCA_ERROR("[kernel-stats-sampling] can't be negative",
+               sampling_ >= 0);
+    dHandle  = dHandle_;
+    sampling = sampling_;
+  }
+
+  kernelLaunchStats& kernelStatsRegistry::getKernelStats(kernel_v *kernel) {
+    if (kernel->launchStats == NULL) {
+      const std::string hash = kernel->properties["hash"].string();
+      kernelLaunchStats &kernelStats = stats[dHandle->getKernelHash(hash, kernel->name)];
+      kernelStats.name = kernel->name;
+      kernelStats.hash = hash;
+      kernel->launchStats = &kernelStats;
+    }
+    return *(kernel->launchStats);
+  }
+
+  bool kernelStatsRegistry::startLaunch(kernel_v *kernel,
+                                        const udim_t argumentBytes,
+                                        const bool isBatched,
+                                        kernelLaunchTag &tag,
+                                        streamTag &startTag) {
+    kernelLaunchStats &kernelStats = getKernelStats(kernel);
+
+    ++kernelStats.launches;
+    kernelStats.argumentBytes += argumentBytes;
+
+    if (isBatched) {
+      ++kernelStats.batchedLaunches;
+      tag.isTimed = tag.isCounted = false;
+      return false;
+    }
+
+    // Sample among the launches that run on their own
+    const udim_t ownLaunches = (kernelStats.launches - kernelStats.batchedLaunches - 1);
+    tag.isTimed = (sampling &&
+                   ((ownLaunches % sampling) == 0));
+    tag.isCounted = (counters != NULL);
+
+    if (tag.isTimed) {
+      startTag = dHandle->tagStream();
+    }
+    // Read last to leave the bookkeeping out of the counts
+    if (tag.isCounted) {
+      tag.startCounters = counters->read();
+    }
+    return (tag.isTimed || tag.isCounted);
+  }
+
+  void kernelStatsRegistry::finishLaunch(kernel_v *kernel,
+                                         const kernelLaunchTag &tag,
+                                         const streamTag &startTag) {
+    kernelLaunchStats &kernelStats = getKernelStats(kernel);
+
+    // CPU launches are done once the kernel call returns
+    if (tag.isCounted) {
+      kernelStats.counters += (counters->read() - tag.startCounters);
+      ++kernelStats.countedLaunches;
+    }
+
+    if (tag.isTimed) {
+      pendingLaunch *launch = new pendingLaunch();
+      launch->stats    = &kernelStats;
+      launch->startTag = startTag;
+      launch->endTag   = dHandle->tagStream();
+      pendingLaunches.push_back(launch);
+
+      if ((int) pendingLaunches.size() >= maxPendingLaunches) {
+        resolvePending();
+      }
+    }
+  }
+
+  bool kernelStatsRegistry::enablePerfCounters() {
+    if (counters == NULL) {
+      counters = new perfCounters();
+      if (!counters->setup()) {
+        delete counters;
+        counters = NULL;
+      }
+    }
+    return counters;
+  }
+
+  void kernelStatsRegistry::resolvePending() {
+    const int pendingCount = (int) pendingLaunches.size();
+    for (int i = 0; i < pendingCount; ++i) {
+      pendingLaunch &launch = *(pendingLaunches[i]);
+      launch.stats->addTime(dHandle->timeBetween(launch.startTag,
+                                                 launch.endTag));
+      dHandle->freeStreamTag(launch.startTag);
+      dHandle->freeStreamTag(launch.endTag);
+      delete &launch;
+    }
+    pendingLaunches.clear();
+  }
+
+  const kernelLaunchStatsMap& kernelStatsRegistry::getStats() {
+    resolvePending();
+    return stats;
+  }
+
+  kernelLaunchStats kernelStatsRegistry::getStats(kernel_v *kernel) {
+    resolvePending();
+    return getKernelStats(kernel);
+  }
+
+  std::string kernelStatsRegistry::toString() const {
+    std::stringstream ss;
+    ss << "[" << (dHandle ? dHandle->mode : "") << "] device kernel launches\n";
+
+    kernelLaunchStatsMap::const_iterator it = stats.begin();
+    while (it != stats.end()) {
+      ss << it->second.toString();
+      ++it;
+    }
+    return ss.str();
+  }
+
+  void kernelStatsRegistry::printExitReport() {
+    if (stats.size()) {
+      resolvePending();
+      std::cerr << toString();
+    }
+  }
+  //====================================
+}
@@ -20,6 +20,7 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
  */
 
+#include <algorithm>
 #include <map>
 
 #include "occa/base.hpp"
@@ -28,8 +29,76 @@
 #include "occa/modes/serial/memory.hpp"
 #include "occa/uva.hpp"
 #include "occa/tools/sys.hpp"
+#include "occa/tools/trace.hpp"
 
 namespace occa {
+  //---[ dirtyRanges ]------------------
+  static bool rangeEndsBefore(const dirtyRanges::range &r,
+                              const udim_t offset) {
+    return (r.second < offset);
+  }
+
+  bool dirtyRanges::isEmpty() const {
+    return ranges.empty();
+  }
+
+  udim_t dirtyRanges::bytes() const {
+    udim_t bytes_ = 0;
+    const int rangeCount = (int) ranges.size();
+    for (int i = 0; i < rangeCount; ++i) {
+      bytes_ += (ranges[i].second - ranges[i].first);
+    }
+    return bytes_;
+  }
+
+  void dirtyRanges::clear() {
+    ranges.clear();
+  }
+
+  void dirtyRanges::add(const udim_t start, const udim_t end) {
+    if (end <= start) {
+      return;
+    }
+    rangeVector::iterator first = std::lower_bound(ranges.begin(),
+                                                   ranges.end(),
+                                                   start,
+                                                   rangeEndsBefore);
+    rangeVector::iterator last = first;
+
+    range merged(start, end);
+    while ((last != ranges.end()) &&
+           (last->first <= end)) {
+      merged.first  = std::min(merged.first, last->first);
+      merged.second = std::max(merged.second, last->second);
+      ++last;
+    }
+    first = ranges.erase(first, last);
+    ranges.insert(first, merged);
+  }
+
+  void dirtyRanges::remove(const udim_t start, const udim_t end,
+                           rangeVector &removed) {
+    rangeVector kept;
+    const int rangeCount = (int) ranges.size();
+    for (int i = 0; i < rangeCount; ++i) {
+      const range &r = ranges[i];
+      if ((r.second <= start) || (end <= r.first)) {
+        kept.push_back(r);
+        continue;
+      }
+      if (r.first < start) {
+        kept.push_back(range(r.first, start));
+      }
+      removed.push_back(range(std::max(r.first, start),
+                              std::min(r.second, end)));
+      if (end < r.second) {
+        kept.push_back(range(end, r.second));
+      }
+    }
+    ranges.swap(kept);
+  }
+  //====================================
+
   //---[ memory_v ]---------------------
   memory_v::memory_v(const occa::properties &properties_) {
     memInfo = uvaFlag::none;
@@ -40,6 +109,8 @@ namespace occa {
 
     dHandle = NULL;
     size    = 0;
+
+    staleIndex = -1;
   }
 
   memory_v::~memory_v() {}
@@ -56,15 +127,32 @@ namespace occa {
     return (memInfo & uvaFlag::isStale);
   }
 
+  bool memory_v::tracksDirty() const {
+    return (memInfo & uvaFlag::tracksDirty);
+  }
+
+  void memory_v::syncDirtyToDevice(const udim_t start, const udim_t end) {
+    dirtyRanges::rangeVector pieces;
+    dirty.remove(start, end, pieces);
+
+    const int pieceCount = (int) pieces.size();
+    for (int i = 0; i < pieceCount; ++i) {
+      const udim_t offset = pieces[i].first;
+      copyFrom(uvaPtr + offset,
+               pieces[i].second - offset,
+               offset);
+    }
+  }
+
   //---[ memory ]-----------------------
   memory::memory() :
     mHandle(NULL) {}
 
   memory::memory(void *uvaPtr) :
     mHandle(NULL) {
-    ptrRangeMap::iterator it = uvaMap.find(uvaPtr);
-    if (it != uvaMap.end()) {
-      setMHandle(it->second);
+    memory_v *mHandle_ = uvaMap.find(uvaPtr);
+    if (mHandle_ != NULL) {
+      setMHandle(mHandle_);
     } else {
       setMHandle((memory_v*) uvaPtr);
     }
@@ -193,12 +281,12 @@ namespace occa {
     range.start = mHandle->uvaPtr;
     range.end   = (range.start + mHandle->size);
 
-    uvaMap[range]                   = mHandle;
-    mHandle->dHandle->uvaMap[range] = mHandle;
+    uvaMap.insert(range, mHandle);
+    mHandle->dHandle->uvaMap.insert(range, mHandle);
 
     // Needed for kernelArg.void_ -> mHandle checks
     if (mHandle->uvaPtr != mHandle->ptr) {
-      uvaMap[mHandle->ptr] = mHandle;
+      uvaMap.insert(ptrRange(mHandle->ptr), mHandle);
     }
   }
 
@@ -231,7 +319,14 @@ namespace occa {
       return;
     }
 
-    copyFrom(mHandle->uvaPtr, bytes_, offset);
+    if (mHandle->tracksDirty() && mHandle->inDevice()) {
+      mHandle->syncDirtyToDevice(offset, offset + bytes_);
+    } else {
+      copyFrom(mHandle->uvaPtr, bytes_, offset);
+
+      dirtyRanges::rangeVector copied;
+      mHandle->dirty.remove(offset, offset + bytes_, copied);
+    }
 
     mHandle->memInfo |=  uvaFlag::inDevice;
     mHandle->memInfo &= ~uvaFlag::isStale;
@@ -262,12 +357,45 @@ namespace occa {
 
     copyTo(mHandle->uvaPtr, bytes_, offset);
 
-    mHandle->memInfo &= ~uvaFlag::inDevice;
+    // Host writes in the synced range were overwritten
+    dirtyRanges::rangeVector overwritten;
+    mHandle->dirty.remove(offset, offset + bytes_, overwritten);
+
+    // Tracked memory keeps using the device copy, later host writes
+    //   are reported through markDirty() and occa::memcpy marks the
+    //   host copy stale again
+    if (!mHandle->tracksDirty()) {
+      mHandle->memInfo &= ~uvaFlag::inDevice;
+    }
     mHandle->memInfo &= ~uvaFlag::isStale;
 
     removeFromStaleMap(mHandle);
   }
 
+  void memory::markDirty(const dim_t offset,
+                         const dim_t bytes) {
+    OCCA_ERROR("Cannot have a negative offset (" << offset << ")",
+               offset >= 0);
+    OCCA_ERROR("Trying to mark negative bytes (" << bytes << ")",
+               bytes >= -1);
+
+    udim_t bytes_ = ((bytes == -1) ? (mHandle->size - offset) : bytes);
+
+    OCCA_ERROR("Memory has size [" << mHandle->size << "],"
+               << " trying to access [ " << offset << " , " << (offset + bytes_) << " ]",
+               (bytes_ + offset) <= mHandle->size);
+
+    mHandle->memInfo |= uvaFlag::tracksDirty;
+
+    if (mHandle->dHandle->hasSeparateMemorySpace()) {
+      mHandle->dirty.add(offset, offset + bytes_);
+    }
+  }
+
+  udim_t memory::dirtyBytes() const {
+    return mHandle->dirty.bytes();
+  }
+
   bool memory::uvaIsStale() const {
     return (mHandle && mHandle->isStale());
   }
@@ -318,6 +446,11 @@ namespace occa {
     return *this;
   }
 
+  memoryView memory::view(const dim_t offset,
+                          const dim_t bytes) const {
+    return memoryView(*this, offset, bytes);
+  }
+
   void memory::copyFrom(const void *src,
                         const dim_t bytes,
                         const dim_t offset,
@@ -332,6 +465,8 @@ namespace occa {
                << "trying to access [ " << offset << " , " << (offset + bytes_) << " ]",
                (bytes_ + offset) <= mHandle->size);
 
+    trace::scope traceScope("memory", "copyFrom");
+    traceScope.addArg("bytes", bytes_);
     mHandle->copyFrom(src, bytes_, offset, props);
   }
 
@@ -355,6 +490,8 @@ namespace occa {
                << "trying to access [ " << destOffset << " , " << (destOffset + bytes_) << " ]",
                (bytes_ + destOffset) <= mHandle->size);
 
+    trace::scope traceScope("memory", "copyFrom");
+    traceScope.addArg("bytes", bytes_);
     mHandle->copyFrom(src.mHandle, bytes_, destOffset, srcOffset, props);
   }
 
@@ -372,6 +509,8 @@ namespace occa {
                << "trying to access [ " << offset << " , " << (offset + bytes_) << " ]",
                (bytes_ + offset) <= mHandle->size);
 
+    trace::scope traceScope("memory", "copyTo");
+    traceScope.addArg("bytes", bytes_);
     mHandle->copyTo(dest, bytes_, offset, props);
   }
 
@@ -395,6 +534,8 @@ namespace occa {
                << "trying to access [ " << destOffset << " , " << (destOffset + bytes_) << " ]",
                (bytes_ + destOffset) <= dest.mHandle->size);
 
+    trace::scope traceScope("memory", "copyTo");
+    traceScope.addArg("bytes", bytes_);
     dest.mHandle->copyFrom(mHandle, bytes_, destOffset, srcOffset, props);
   }
 
@@ -430,7 +571,11 @@ namespace occa {
     if (mHandle == NULL) {
       return;
     }
-    mHandle->dHandle->bytesAllocated -= (mHandle->size);
+    mHandle->dHandle->allocations.remove(mHandle);
+
+    removeFromStaleMap(mHandle);
+    mHandle->dirty.clear();
+    mHandle->memInfo &= ~uvaFlag::tracksDirty;
 
     if (mHandle->uvaPtr) {
       uvaMap.erase(mHandle->uvaPtr);
@@ -439,19 +584,174 @@ namespace occa {
       // CPU case where memory is shared
       if (mHandle->uvaPtr != mHandle->ptr) {
         uvaMap.erase(mHandle->ptr);
-        mHandle->dHandle->uvaMap.erase(mHandle->uvaPtr);
 
         ::free(mHandle->uvaPtr);
         mHandle->uvaPtr = NULL;
       }
     }
 
-    if (freeMemory) {
+    memoryPool *pool = mHandle->dHandle->findMemoryPool(mHandle);
+
+    if (pool) {
+      pool->release(mHandle, freeMemory);
+    } else if (freeMemory) {
       mHandle->free();
     } else {
       mHandle->detach();
     }
   }
+  //====================================
+
+  //---[ memoryView ]-------------------
+  memoryView::memoryView() :
+    offset_(0),
+    size_(0) {}
+
+  memoryView::memoryView(const occa::memory &mem_,
+                         const dim_t offset,
+                         const dim_t bytes) :
+    mem(mem_),
+    offset_(offset),
+    size_(0) {
+
+    OCCA_ERROR("Memory not initialized",
+               mem.isInitialized());
+    OCCA_ERROR("Cannot have a negative offset (" << offset << ")",
+               offset >= 0);
+    OCCA_ERROR("Cannot have an offset greater than the memory size ("
+               << offset << " > " << mem.size() << ")",
+               offset <= (dim_t) mem.size());
+
+    size_ = ((bytes == -1) ? (mem.size() - offset) : bytes);
+
+    OCCA_ERROR("Memory has size [" << mem.size() << "],"
+               << " trying to view [ " << offset << " , " << (offset + size_) << " ]",
+               (offset + size_) <= mem.size());
+  }
+
+  bool memoryView::isInitialized() const {
+    return mem.isInitialized();
+  }
+
+  occa::memory memoryView::getMemory() const {
+    return mem;
+  }
+
+  memory_v* memoryView::getMHandle() const {
+    return mem.getMHandle();
+  }
+
+  device_v* memoryView::getDHandle() const {
+    return mem.getDHandle();
+  }
+
+  occa::device memoryView::getDevice() const {
+    return mem.getDevice();
+  }
+
+  void* memoryView::ptr() {
+    char *ptr_ = (char*) mem.ptr();
+    return (ptr_ ? (ptr_ + offset_) : NULL);
+  }
+
+  const void* memoryView::ptr() const {
+    const char *ptr_ = (const char*) mem.ptr();
+    return (ptr_ ? (ptr_ + offset_) : NULL);
+  }
+
+  udim_t memoryView::offset() const {
+    return offset_;
+  }
+
+  udim_t memoryView::size() const {
+    return size_;
+  }
+
+  memoryView::operator kernelArg() const {
+    return mem.getMHandle()->makeOffsetKernelArg(offset_);
+  }
+
+  memoryView memoryView::operator + (const dim_t offset) const {
+    OCCA_ERROR("Cannot have a negative offset (" << offset << ")",
+               offset >= 0);
+    OCCA_ERROR("Cannot have an offset greater than the view size ("
+               << offset << " > " << size_ << ")",
+               offset <= (dim_t) size_);
+
+    return memoryView(mem, offset_ + offset, size_ - offset);
+  }
+
+  memoryView& memoryView::operator += (const dim_t offset) {
+    *this = (*this + offset);
+    return *this;
+  }
+
+  void memoryView::copyFrom(const void *src,
+                            const dim_t bytes,
+                            const dim_t offset,
+                            const occa::properties &props) {
+    const dim_t bytes_ = ((bytes == -1) ? (size_ - offset) : bytes);
+
+    OCCA_ERROR("View has size [" << size_ << "],"
+               << " trying to access [ " << offset << " , " << (offset + bytes_) << " ]",
+               (offset + bytes_) <= (dim_t) size_);
+
+    mem.copyFrom(src, bytes_, offset_ + offset, props);
+  }
+
+  void memoryView::copyFrom(const memoryView src,
+                            const dim_t bytes,
+                            const dim_t destOffset,
+                            const dim_t srcOffset,
+                            const occa::properties &props) {
+    const dim_t bytes_ = ((bytes == -1) ? (size_ - destOffset) : bytes);
+
+    OCCA_ERROR("Source view has size [" << src.size_ << "],"
+               << " trying to access [ " << srcOffset << " , " << (srcOffset + bytes_) << " ]",
+               (srcOffset + bytes_) <= (dim_t) src.size_);
+    OCCA_ERROR("Destination view has size [" << size_ << "],"
+               << " trying to access [ " << destOffset << " , " << (destOffset + bytes_) << " ]",
+               (destOffset + bytes_) <= (dim_t) size_);
+
+    mem.copyFrom(src.mem, bytes_,
+                 offset_ + destOffset,
+                 src.offset_ + srcOffset,
+                 props);
+  }
+
+  void memoryView::copyTo(void *dest,
+                          const dim_t bytes,
+                          const dim_t offset,
+                          const occa::properties &props) const {
+    const dim_t bytes_ = ((bytes == -1) ? (size_ - offset) : bytes);
+
+    OCCA_ERROR("View has size [" << size_ << "],"
+               << " trying to access [ " << offset << " , " << (offset + bytes_) << " ]",
+               (offset + bytes_) <= (dim_t) size_);
+
+    mem.copyTo(dest, bytes_, offset_ + offset, props);
+  }
+
+  void memoryView::copyTo(const memoryView dest,
+                          const dim_t bytes,
+                          const dim_t destOffset,
+                          const dim_t srcOffset,
+                          const occa::properties &props) const {
+    const dim_t bytes_ = ((bytes == -1) ? (size_ - srcOffset) : bytes);
+
+    OCCA_ERROR("Source view has size [" << size_ << "],"
+               << " trying to access [ " << srcOffset << " , " << (srcOffset + bytes_) << " ]",
+               (srcOffset + bytes_) <= (dim_t) size_);
+    OCCA_ERROR("Destination view has size [" << dest.size_ << "],"
+               << " trying to access [ " << destOffset << " , " << (destOffset + bytes_) << " ]",
+               (destOffset + bytes_) <= (dim_t) dest.size_);
+
+    mem.copyTo(dest.mem, bytes_,
+               dest.offset_ + destOffset,
+               offset_ + srcOffset,
+               props);
+  }
+  //====================================
 
   namespace cpu {
     occa::memory wrapMemory(void *ptr, const udim_t bytes) {
@@ -0,0 +1,303 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2014-2018 David Medina and Tim Warburton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ */
+
+#include <sstream>
+
+#include "occa/memoryPool.hpp"
+#include "occa/memory.hpp"
+#include "occa/device.hpp"
+#include "occa/tools/string.hpp"
+
+namespace occa {
+  //---[ memoryPoolStats ]--------------
+  memoryPoolStats::memoryPoolStats() :
+    reservedBytes(0),
+    peakReservedBytes(0),
+    usedBytes(0),
+    peakUsedBytes(0),
+    allocations(0),
+    reusedAllocations(0),
+    backendAllocations(0),
+    backendFrees(0) {}
+
+  memoryPoolStats& memoryPoolStats::operator += (const memoryPoolStats &other) {
+    reservedBytes      += other.reservedBytes;
+    peakReservedBytes  += other.peakReservedBytes;
+    usedBytes          += other.usedBytes;
+    peakUsedBytes      += other.peakUsedBytes;
+    allocations        += other.allocations;
+    reusedAllocations  += other.reusedAllocations;
+    backendAllocations += other.backendAllocations;
+    backendFrees       += other.backendFrees;
+    return *this;
+  }
+
+  static std::string bytesToString(const udim_t bytes) {
+    return (bytes ? stringifyBytes(bytes) : "0 bytes");
+  }
+
+  std::string memoryPoolStats::toString() const {
+    std::stringstream ss;
+    ss << "reserved: "    << bytesToString(reservedBytes)
+       << " (peak "       << bytesToString(peakReservedBytes) << ")\n"
+       << "used: "        << bytesToString(usedBytes)
+       << " (peak "       << bytesToString(peakUsedBytes) << ")\n"
+       << "allocations: " << allocations
+       << " (reused "     << reusedAllocations << ")\n"
+       << "backend allocations: " << backendAllocations
+       << ", frees: "             << backendFrees << '\n';
+    return ss.str();
+  }
+  //====================================
+
+  //---[ memoryPool ]-------------------
+  const udim_t memoryPool::alignment;
+
+  memoryPool::block::block(chunk *owner_,
+                           const udim_t offset_,
+                           const udim_t bytes_) :
+    owner(owner_),
+    offset(offset_),
+    bytes(bytes_),
+    isFree(true),
+    handleNeedsFree(false),
+    prev(NULL),
+    next(NULL) {}
+
+  memoryPool::memoryPool(device_v *dHandle_,
+                         const occa::properties &props) :
+    dHandle(dHandle_) {
+
+    const int64_t chunkBytes_ = props.get<int64_t>("pool-chunk-bytes", 1 << 21);
+
+    OCCA_ERROR("[memory/pool-chunk-bytes] must be positive",
+               chunkBytes_ > 0);
+
+    chunkBytes = (udim_t) chunkBytes_;
+  }
+
+  memoryPool::~memoryPool() {
+    // Memory still in use can't reach the pool after this
+    usedBlockMap::iterator it = usedBlocks.begin();
+    while (it != usedBlocks.end()) {
+      memory_v *mem = it->first;
+      if (it->second->handleNeedsFree) {
+        mem->free();
+      } else {
+        mem->detach();
+      }
+      ++it;
+    }
+    usedBlocks.clear();
+    freeBlocks.clear();
+
+    const int chunkCount = (int) chunks.size();
+    for (int i = 0; i < chunkCount; ++i) {
+      freeChunk(chunks[i]);
+    }
+    chunks.clear();
+  }
+
+  memory_v* memoryPool::malloc(const udim_t bytes,
+                               const void *src,
+                               const occa::properties &props) {
+    const udim_t blockBytes = (((bytes + alignment - 1) / alignment) * alignment);
+
+    // Best fit from the size bins
+    block *b = NULL;
+    freeBlockMap::iterator it = freeBlocks.lower_bound(blockBytes);
+    if (it != freeBlocks.end()) {
+      b = it->second;
+      freeBlocks.erase(it);
+      ++stats.reusedAllocations;
+    } else {
+      b = newChunk((blockBytes < chunkBytes) ? chunkBytes : blockBytes,
+                   props);
+    }
+
+    splitBlock(b, blockBytes);
+    b->isFree = false;
+
+    memory_v *mem = b->owner->mHandle->addOffset(b->offset,
+                                                 b->handleNeedsFree);
+    mem->dHandle = dHandle;
+    mem->size    = bytes;
+
+    if (src != NULL) {
+      mem->copyFrom(src, bytes, 0, props);
+    }
+
+    usedBlocks[mem] = b;
+
+    ++stats.allocations;
+    stats.usedBytes += b->bytes;
+    if (stats.peakUsedBytes < stats.usedBytes) {
+      stats.peakUsedBytes = stats.usedBytes;
+    }
+
+    return mem;
+  }
+
+  bool memoryPool::owns(memory_v *mem) const {
+    return (usedBlocks.find(mem) != usedBlocks.end());
+  }
+
+  void memoryPool::release(memory_v *mem, const bool freeBlock) {
+    usedBlockMap::iterator it = usedBlocks.find(mem);
+    if (it == usedBlocks.end()) {
+      return;
+    }
+    block *b = it->second;
+    usedBlocks.erase(it);
+
+    // The handle only points into the chunk
+    if (b->handleNeedsFree) {
+      mem->free();
+    } else {
+      mem->detach();
+    }
+    b->handleNeedsFree = false;
+
+    // Detached memory keeps its block until the device is freed
+    if (!freeBlock) {
+      return;
+    }
+
+    stats.usedBytes -= b->bytes;
+    b->isFree = true;
+
+    if (b->next && b->next->isFree) {
+      removeFreeBlock(b->next);
+      b = mergeBlocks(b, b->next);
+    }
+    if (b->prev && b->prev->isFree) {
+      removeFreeBlock(b->prev);
+      b = mergeBlocks(b->prev, b);
+    }
+
+    addFreeBlock(b);
+  }
+
+  void memoryPool::trim() {
+    int unused = 0;
+    const int chunkCount = (int) chunks.size();
+
+    for (int i = 0; i < chunkCount; ++i) {
+      chunk *c = chunks[i];
+      block *b = c->firstBlock;
+
+      if (b->isFree && (b->next == NULL)) {
+        removeFreeBlock(b);
+        freeChunk(c);
+      } else {
+        chunks[unused++] = c;
+      }
+    }
+    chunks.resize(unused);
+  }
+
+  const memoryPoolStats& memoryPool::getStats() const {
+    return stats;
+  }
+
+  memoryPool::block* memoryPool::newChunk(const udim_t bytes,
+                                          const occa::properties &props) {
+    chunk *c = new chunk();
+    c->mHandle = dHandle->malloc(bytes, NULL, props);
+    c->mHandle->dHandle = dHandle;
+    c->bytes = bytes;
+    c->firstBlock = new block(c, 0, bytes);
+
+    chunks.push_back(c);
+
+    ++stats.backendAllocations;
+    stats.reservedBytes += bytes;
+    if (stats.peakReservedBytes < stats.reservedBytes) {
+      stats.peakReservedBytes = stats.reservedBytes;
+    }
+
+    return c->firstBlock;
+  }
+
+  void memoryPool::freeChunk(chunk *c) {
+    block *b = c->firstBlock;
+    while (b) {
+      block *next = b->next;
+      delete b;
+      b = next;
+    }
+
+    c->mHandle->free();
+    delete c->mHandle;
+
+    ++stats.backendFrees;
+    stats.reservedBytes -= c->bytes;
+
+    delete c;
+  }
+
+  void memoryPool::addFreeBlock(block *b) {
+    freeBlocks.insert(std::make_pair(b->bytes, b));
+  }
+
+  void memoryPool::removeFreeBlock(block *b) {
+    std::pair<freeBlockMap::iterator, freeBlockMap::iterator> range =
+      freeBlocks.equal_range(b->bytes);
+
+    for (freeBlockMap::iterator it = range.first; it != range.second; ++it) {
+      if (it->second == b) {
+        freeBlocks.erase(it);
+        return;
+      }
+    }
+  }
+
+  void memoryPool::splitBlock(block *b, const udim_t bytes) {
+    if ((b->bytes - bytes) < alignment) {
+      return;
+    }
+
+    block *rest = new block(b->owner,
+                            b->offset + bytes,
+                            b->bytes - bytes);
+    rest->prev = b;
+    rest->next = b->next;
+    if (b->next) {
+      b->next->prev = rest;
+    }
+    b->next  = rest;
+    b->bytes = bytes;
+
+    addFreeBlock(rest);
+  }
+
+  memoryPool::block* memoryPool::mergeBlocks(block *left, block *right) {
+    left->bytes += right->bytes;
+    left->next = right->next;
+    if (right->next) {
+      right->next->prev = left;
+    }
+    delete right;
+    return left;
+  }
+  //====================================
+}
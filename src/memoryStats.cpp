@@ -0,0 +1,179 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2014-2018 David Medina and Tim Warburton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ */
+
+#include <iostream>
+#include <sstream>
+
+#include "occa/memoryStats.hpp"
+#include "occa/memory.hpp"
+#include "occa/tools/string.hpp"
+
+namespace occa {
+  //---[ memoryStats ]------------------
+  const int memoryStats::histogramBins;
+
+  memoryTagStats::memoryTagStats() :
+    bytes(0),
+    peakBytes(0),
+    allocations(0) {}
+
+  memoryStats::memoryStats() :
+    bytes(0),
+    peakBytes(0),
+    allocations(0),
+    frees(0),
+    sizeHistogram(histogramBins, 0) {}
+
+  static std::string bytesToString(const udim_t bytes) {
+    return (bytes ? stringifyBytes(bytes) : "0 bytes");
+  }
+
+  std::string memoryStats::toString() const {
+    std::stringstream ss;
+    ss << "allocated: "   << bytesToString(bytes)
+       << " (peak "       << bytesToString(peakBytes) << ")\n"
+       << "allocations: " << allocations
+       << ", frees: "     << frees << '\n';
+
+    for (int i = 0; i < histogramBins; ++i) {
+      if (sizeHistogram[i]) {
+        ss << "  [" << bytesToString(((udim_t) 1) << i) << ", "
+           << ((i < (histogramBins - 1))
+               ? bytesToString(((udim_t) 1) << (i + 1))
+               : std::string("...")) << "): "
+           << sizeHistogram[i] << '\n';
+      }
+    }
+
+    memoryTagStatsMap::const_iterator it = tags.begin();
+    while (it != tags.end()) {
+      const memoryTagStats &tagStats = it->second;
+      ss << "tag [" << it->first << "]: "
+         << bytesToString(tagStats.bytes)
+         << " (peak "       << bytesToString(tagStats.peakBytes)
+         << ", allocations " << tagStats.allocations << ")\n";
+      ++it;
+    }
+    return ss.str();
+  }
+  //====================================
+
+  //---[ memoryTracker ]----------------
+  memoryTracker::memoryTracker() {
+    exitReport::get("OCCA_MEMORY_REPORT").add(this);
+  }
+
+  memoryTracker::~memoryTracker() {
+    exitReport::get("OCCA_MEMORY_REPORT").remove(this);
+  }
+
+  void memoryTracker::setName(const std::string &name_) {
+    name = name_;
+  }
+
+  void memoryTracker::add(memory_v *mem,
+                          const udim_t bytes,
+                          const std::string &tag) {
+    allocation &alloc = liveAllocations[mem];
+    alloc.bytes = bytes;
+    alloc.tag   = tag;
+
+    ++stats.allocations;
+    stats.bytes += bytes;
+    if (stats.peakBytes < stats.bytes) {
+      stats.peakBytes = stats.bytes;
+    }
+
+    int bin = 0;
+    while (((bytes >> (bin + 1)) != 0) &&
+           (bin < (memoryStats::histogramBins - 1))) {
+      ++bin;
+    }
+    ++stats.sizeHistogram[bin];
+
+    if (tag.size()) {
+      memoryTagStats &tagStats = stats.tags[tag];
+      ++tagStats.allocations;
+      tagStats.bytes += bytes;
+      if (tagStats.peakBytes < tagStats.bytes) {
+        tagStats.peakBytes = tagStats.bytes;
+      }
+    }
+  }
+
+  void memoryTracker::remove(memory_v *mem) {
+    allocationMap::iterator it = liveAllocations.find(mem);
+    if (it == liveAllocations.end()) {
+      return;
+    }
+    const allocation &alloc = it->second;
+
+    ++stats.frees;
+    stats.bytes -= alloc.bytes;
+    if (alloc.tag.size()) {
+      stats.tags[alloc.tag].bytes -= alloc.bytes;
+    }
+
+    liveAllocations.erase(it);
+  }
+
+  const memoryStats& memoryTracker::getStats() const {
+    return stats;
+  }
+
+  void memoryTracker::resetPeaks() {
+    stats.peakBytes = stats.bytes;
+
+    memoryTagStatsMap::iterator it = stats.tags.begin();
+    while (it != stats.tags.end()) {
+      it->second.peakBytes = it->second.bytes;
+      ++it;
+    }
+  }
+
+  std::string memoryTracker::liveReport() const {
+    std::stringstream ss;
+    ss << "[" << name << "] device has "
+       << liveAllocations.size() << " live allocations ("
+       << bytesToString(stats.bytes) << ")\n";
+
+    allocationMap::const_iterator it = liveAllocations.begin();
+    while (it != liveAllocations.end()) {
+      const allocation &alloc = it->second;
+      ss << "  " << (void*) it->first << ": "
+         << bytesToString(alloc.bytes);
+      if (alloc.tag.size()) {
+        ss << " [" << alloc.tag << "]";
+      }
+      ss << '\n';
+      ++it;
+    }
+    return ss.str();
+  }
+
+  void memoryTracker::printExitReport() {
+    if (liveAllocations.size()) {
+      std::cerr << liveReport();
+    }
+  }
+  //====================================
+}
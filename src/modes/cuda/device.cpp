@@ -156,6 +156,11 @@ namespace occa {
       return (double) (1.0e-3 * (double) msTimeTaken);
     }
 
+    void device::freeStreamTag(const streamTag &tag) const {
+      OCCA_CUDA_ERROR("Device: Freeing Tag",
+                      cuEventDestroy(cuda::event(tag)));
+    }
+
     stream_t device::wrapStream(void *handle_, const occa::properties &props) const {
       return handle_;
     }
@@ -51,6 +51,20 @@ namespace occa {
       return kernelArg(arg);
     }
 
+    kernelArg memory::makeOffsetKernelArg(const udim_t offset) const {
+      kernelArgData arg;
+
+      arg.dHandle = dHandle;
+      arg.mHandle = const_cast<memory*>(this);
+
+      // Store the offset pointer by value, ptr() returns its address
+      arg.data.uint64_ = (uint64_t) (cuPtr + offset);
+      arg.size         = sizeof(void*);
+      arg.info         = kArgInfo::none;
+
+      return kernelArg(arg);
+    }
+
     memory_v* memory::addOffset(const dim_t offset, bool &needsFree) {
       memory *m = new memory(properties);
       m->cuPtr = cuPtr + offset;
@@ -0,0 +1,53 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2014-2018 David Medina and Tim Warburton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ */
+
+#include "occa/modes/emulated/device.hpp"
+#include "occa/tools/sys.hpp"
+#include "occa/base.hpp"
+
+namespace occa {
+  namespace emulated {
+    device::device(const occa::properties &properties_) :
+      serial::device(properties_) {
+
+      bandwidth = properties.get("bandwidth", 16.0);
+      latency   = properties.get("latency", 10.0);
+
+      OCCA_ERROR("[Emulated] bandwidth must be positive",
+                 bandwidth > 0);
+      OCCA_ERROR("[Emulated] latency can't be negative",
+                 latency >= 0);
+    }
+
+    bool device::hasSeparateMemorySpace() const {
+      return true;
+    }
+
+    void device::finishTransfer(const udim_t bytes,
+                                const double startTime) const {
+      const double transferTime = ((1.0e-6 * latency)
+                                   + (bytes / (1.0e9 * bandwidth)));
+
+      sys::sleep(startTime + transferTime - sys::currentTime());
+    }
+  }
+}
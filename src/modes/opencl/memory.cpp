@@ -50,6 +50,41 @@ namespace occa {
       return kernelArg(arg);
     }
 
+    kernelArg memory::makeOffsetKernelArg(const udim_t offset) const {
+      if (offset == 0) {
+        return makeKernelArg();
+      }
+
+      // OpenCL can't offset a cl_mem, cache a sub-buffer per offset
+      std::map<udim_t, cl_mem>::iterator it = subBuffers.find(offset);
+      if (it == subBuffers.end()) {
+        cl_buffer_region info;
+        info.origin = offset;
+        info.size   = size - offset;
+
+        cl_int error;
+        cl_mem subBuffer = clCreateSubBuffer(clMem,
+                                             CL_MEM_READ_WRITE,
+                                             CL_BUFFER_CREATE_TYPE_REGION,
+                                             &info,
+                                             &error);
+
+        OCCA_OPENCL_ERROR("Device: clCreateSubBuffer", error);
+        it = subBuffers.insert(std::make_pair(offset, subBuffer)).first;
+      }
+
+      kernelArgData arg;
+
+      arg.dHandle = dHandle;
+      arg.mHandle = const_cast<memory*>(this);
+
+      arg.data.void_ = (void*) &(it->second);
+      arg.size       = sizeof(void*);
+      arg.info       = kArgInfo::usePointer;
+
+      return kernelArg(arg);
+    }
+
     memory_v* memory::addOffset(const dim_t offset, bool &needsFree) {
       opencl::device &dev = *((opencl::device*) dHandle);
       opencl::memory *m = new opencl::memory();
@@ -118,7 +153,19 @@ namespace occa {
                                             0, NULL, NULL));
     }
 
+    void memory::freeSubBuffers() {
+      std::map<udim_t, cl_mem>::iterator it = subBuffers.begin();
+      while (it != subBuffers.end()) {
+        OCCA_OPENCL_ERROR("Sub-buffer Free: clReleaseMemObject",
+                          clReleaseMemObject(it->second));
+        ++it;
+      }
+      subBuffers.clear();
+    }
+
     void memory::free() {
+      freeSubBuffers();
+
       if (mappedPtr) {
         cl_command_queue &stream = *((cl_command_queue*) dHandle->currentStream);
 
@@ -137,6 +184,7 @@ namespace occa {
     }
 
     void memory::detach() {
+      freeSubBuffers();
       size = 0;
     }
   }
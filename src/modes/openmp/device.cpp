@@ -24,19 +24,74 @@
 
 #if OCCA_OPENMP_ENABLED
 
+#include <algorithm>
+
 #include <omp.h>
 
 #include "occa/modes/serial/device.hpp"
 #include "occa/modes/openmp/device.hpp"
 #include "occa/modes/openmp/kernel.hpp"
 #include "occa/modes/openmp/utils.hpp"
+#include "occa/memory.hpp"
+#include "occa/tools/sys.hpp"
 
 namespace occa {
   namespace openmp {
+    namespace {
+      const occa::properties::path oklPath("OKL");
+    }
+
+    //---[ Nested Launch ]--------------
+    addressRange::addressRange(const char *start_,
+                               const char *end_,
+                               const bool isWritten_) :
+      start(start_),
+      end(end_),
+      isWritten(isWritten_) {}
+
+    bool addressRange::conflictsWith(const addressRange &r) const {
+      if (!isWritten && !r.isWritten) {
+        return false;
+      }
+      // Unknown ranges (NULL) conflict with everything
+      if ((start == NULL) || (r.start == NULL)) {
+        return true;
+      }
+      return ((start < r.end) && (r.start < end));
+    }
+
+    nestedLaunch::nestedLaunch() :
+      handle(NULL),
+      passesKernelInfo(true),
+      needsBarrier(false),
+      threads(0) {}
+
+    int nestedLaunch::getArgs(void **vArgs) {
+      int argc = 0;
+      if (passesKernelInfo) {
+        vArgs[argc++] = &info;
+      }
+      const int kArgc = (int) args.size();
+      for (int i = 0; i < kArgc; ++i) {
+        const int argCount = (int) args[i].args.size();
+        for (int j = 0; j < argCount; ++j) {
+          vArgs[argc++] = args[i].args[j].ptr();
+        }
+      }
+      return argc;
+    }
+    //==================================
+
     device::device(const occa::properties &properties_) :
-      serial::device(properties_) {
+      serial::device(properties_),
+      nestedLaunchDepth(0) {
       // Generate an OpenMP library dependency (so it doesn't crash when dlclose())
       omp_get_num_threads();
+
+      const dim_t parallelCopyBytes_ = properties.get<dim_t>("parallel-copy-bytes", 4 << 20);
+      OCCA_ERROR("[parallel-copy-bytes] must be positive",
+                 parallelCopyBytes_ > 0);
+      parallelCopyBytes = parallelCopyBytes_;
     }
 
     kernel_v* device::buildKernel(const std::string &filename,
@@ -75,6 +130,209 @@ namespace occa {
       k->build(filename, kernelName, kernelHash);
       return k;
     }
+
+    void device::firstTouch(char *ptr,
+                            const void *src,
+                            const udim_t bytes) {
+      // Split pages the same way [omp for] splits outer loops
+      const dim_t pageBytes = 4096;
+      const dim_t pages = (bytes + pageBytes - 1) / pageBytes;
+
+#pragma omp parallel for schedule(static)
+      for (dim_t page = 0; page < pages; ++page) {
+        const dim_t offset     = page * pageBytes;
+        const dim_t pageBytes_ = ((offset + pageBytes) <= (dim_t) bytes
+                                  ? pageBytes
+                                  : (bytes - offset));
+        if (src != NULL) {
+          ::memcpy(ptr + offset, ((const char*) src) + offset, pageBytes_);
+        } else {
+          ::memset(ptr + offset, 0, pageBytes_);
+        }
+      }
+    }
+
+    void device::bulkCopy(void *dest,
+                          const void *src,
+                          const udim_t bytes,
+                          const bool nonTemporal) const {
+      if ((bytes < parallelCopyBytes) || omp_in_parallel()) {
+        serial::device::bulkCopy(dest, src, bytes, nonTemporal);
+        return;
+      }
+
+#pragma omp parallel
+      {
+        const udim_t threads = omp_get_num_threads();
+        const udim_t thread  = omp_get_thread_num();
+
+        // Keep thread boundaries on cache lines
+        const udim_t chunkBytes = (((bytes + threads - 1) / threads + 63) / 64) * 64;
+        const udim_t start = std::min(bytes, thread * chunkBytes);
+        const udim_t end   = std::min(bytes, start + chunkBytes);
+
+        if (start < end) {
+          serial::device::bulkCopy(((char*) dest) + start,
+                                   ((const char*) src) + start,
+                                   end - start,
+                                   nonTemporal);
+        }
+      }
+    }
+
+    void device::startNestedLaunches() {
+      ++nestedLaunchDepth;
+    }
+
+    void device::finishNestedLaunches() {
+      if (--nestedLaunchDepth) {
+        return;
+      }
+      flushNestedLaunches();
+    }
+
+    void device::flushNestedLaunches() {
+      const int launches = (int) nestedLaunches.size();
+      if (launches == 0) {
+        return;
+      }
+
+      const int maxArgs = 2*OCCA_MAX_ARGS;
+      std::vector<void*> vArgs(launches * maxArgs);
+      std::vector<int> argc(launches);
+      for (int i = 0; i < launches; ++i) {
+        argc[i] = nestedLaunches[i].getArgs(&(vArgs[i * maxArgs]));
+      }
+
+      // Batched launches share [openmp/threads] and [openmp/proc_bind]
+      const int threads = (nestedLaunches[0].threads
+                           ? nestedLaunches[0].threads
+                           : omp_get_max_threads());
+      const std::string &procBind = nestedLaunches[0].procBind;
+
+#if _OPENMP >= 201307
+      if (procBind == "master") {
+#pragma omp parallel num_threads(threads) proc_bind(master)
+        runNestedLaunches(vArgs, argc);
+      }
+      else if (procBind == "close") {
+#pragma omp parallel num_threads(threads) proc_bind(close)
+        runNestedLaunches(vArgs, argc);
+      }
+      else if (procBind == "spread") {
+#pragma omp parallel num_threads(threads) proc_bind(spread)
+        runNestedLaunches(vArgs, argc);
+      }
+      else
+#endif
+      {
+#pragma omp parallel num_threads(threads)
+        runNestedLaunches(vArgs, argc);
+      }
+
+      nestedLaunches.clear();
+      unsyncedRanges.clear();
+    }
+
+    void device::cancelNestedLaunches() {
+      if (--nestedLaunchDepth) {
+        return;
+      }
+      nestedLaunches.clear();
+      unsyncedRanges.clear();
+    }
+
+    void device::runNestedLaunches(std::vector<void*> &vArgs,
+                                   const std::vector<int> &argc) {
+      const int launches = (int) nestedLaunches.size();
+      const int maxArgs  = 2*OCCA_MAX_ARGS;
+
+      // Each nested kernel splits its outer loop with [omp for nowait],
+      //   barriers are only added between launches that share memory
+      for (int i = 0; i < launches; ++i) {
+        if (nestedLaunches[i].needsBarrier) {
+#pragma omp barrier
+        }
+        sys::runFunction(nestedLaunches[i].handle,
+                         argc[i],
+                         &(vArgs[i * maxArgs]));
+      }
+    }
+
+    bool device::isBatchingLaunches() const {
+      return nestedLaunchDepth;
+    }
+
+    void device::addNestedLaunch(const openmp::kernel &kernel,
+                                 handleFunction_t handle,
+                                 const int kArgc,
+                                 const kernelArg *kArgs) {
+      const int threads = openmp::kernel::getThreads(kernel.properties);
+      const std::string procBind = openmp::kernel::getProcBind(kernel.properties);
+
+      // Launches with other parallel region settings start a new batch
+      if (nestedLaunches.size() &&
+          ((threads != nestedLaunches[0].threads) ||
+           (procBind != nestedLaunches[0].procBind))) {
+        flushNestedLaunches();
+      }
+
+      nestedLaunches.push_back(nestedLaunch());
+      nestedLaunch &launch = nestedLaunches.back();
+
+      launch.handle = handle;
+      launch.passesKernelInfo = kernel.properties.get(oklPath, true);
+      launch.threads  = threads;
+      launch.procBind = procBind;
+
+      serial::kernelInfoArg_t &info = launch.info;
+      info.outerDim0 = kernel.outer.x; info.innerDim0 = kernel.inner.x;
+      info.outerDim1 = kernel.outer.y; info.innerDim1 = kernel.inner.y;
+      info.outerDim2 = kernel.outer.z; info.innerDim2 = kernel.inner.z;
+      info.innerId0 = info.innerId1 = info.innerId2 = 0;
+
+      launch.args.assign(kArgs, kArgs + kArgc);
+
+      // Find the memory this launch touches
+      //   (metadata argument 0 is the kernel info when it's passed)
+      const int metadataOffset = launch.passesKernelInfo;
+      std::vector<addressRange> ranges;
+      for (int i = 0; i < kArgc; ++i) {
+        const bool isWritten = !kernel.metadata.argIsConst(i + metadataOffset);
+        const int argCount = (int) kArgs[i].args.size();
+
+        for (int j = 0; j < argCount; ++j) {
+          const kernelArgData &arg = kArgs[i].args[j];
+          if (!(arg.info & kArgInfo::usePointer)) {
+            continue;
+          }
+          if (arg.mHandle) {
+            ranges.push_back(addressRange(arg.mHandle->ptr,
+                                          arg.mHandle->ptr + arg.mHandle->size,
+                                          isWritten));
+          } else {
+            ranges.push_back(addressRange(NULL, NULL, isWritten));
+          }
+        }
+      }
+
+      const int rangeCount = (int) ranges.size();
+      const int unsyncedCount = (int) unsyncedRanges.size();
+      for (int i = 0; !launch.needsBarrier && (i < rangeCount); ++i) {
+        for (int j = 0; j < unsyncedCount; ++j) {
+          if (ranges[i].conflictsWith(unsyncedRanges[j])) {
+            launch.needsBarrier = true;
+            break;
+          }
+        }
+      }
+
+      if (launch.needsBarrier) {
+        unsyncedRanges.clear();
+      }
+      unsyncedRanges.insert(unsyncedRanges.end(),
+                            ranges.begin(), ranges.end());
+    }
   }
 }
 
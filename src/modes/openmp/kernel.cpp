@@ -26,18 +26,119 @@
 
 #include <omp.h>
 
+#include <sstream>
+
+#include "occa/modes/openmp/device.hpp"
 #include "occa/modes/openmp/kernel.hpp"
 #include "occa/tools/env.hpp"
 #include "occa/tools/io.hpp"
 
 namespace occa {
   namespace openmp {
+    namespace {
+      const occa::properties::path threadsPath("openmp/threads");
+      const occa::properties::path procBindPath("openmp/proc_bind");
+      const occa::properties::path fusePath("openmp/fuse");
+    }
+
     kernel::kernel(const occa::properties &properties_) :
       serial::kernel(properties_) {
 
       properties["occa/kernel/defines"] =
         io::cacheFile(env::OCCA_DIR + "/include/occa/modes/openmp/kernelDefines.hpp",
                       "openmpKernelDefines.hpp");
+
+      properties["defines/OCCA_OPENMP_FOR_CLAUSES"]      = forClauses(properties);
+      properties["defines/OCCA_OPENMP_PARALLEL_CLAUSES"] = parallelClauses(properties);
+    }
+
+    std::string kernel::forClauses(const occa::properties &props) {
+      std::stringstream ss;
+
+      if (props.has("openmp/schedule")) {
+        const std::string schedule = props.get<std::string>("openmp/schedule");
+
+        OCCA_ERROR("[openmp/schedule] must be one of:"
+                   " static, dynamic, guided, auto, runtime",
+                   (schedule == "static")  ||
+                   (schedule == "dynamic") ||
+                   (schedule == "guided")  ||
+                   (schedule == "auto")    ||
+                   (schedule == "runtime"));
+
+        ss << "schedule(" << schedule;
+
+        if (props.has("openmp/chunk")) {
+          const int chunk = props.get("openmp/chunk", 0);
+
+          OCCA_ERROR("[openmp/chunk] must be positive",
+                     0 < chunk);
+          OCCA_ERROR("[openmp/chunk] is not allowed with auto or runtime schedules",
+                     (schedule != "auto") && (schedule != "runtime"));
+
+          ss << ", " << chunk;
+        }
+        ss << ')';
+      } else {
+        OCCA_ERROR("[openmp/chunk] requires [openmp/schedule]",
+                   !props.has("openmp/chunk"));
+      }
+
+      return ss.str();
+    }
+
+    std::string kernel::parallelClauses(const occa::properties &props) {
+      std::stringstream ss;
+
+      const int threads = getThreads(props);
+      if (threads) {
+        ss << "num_threads(" << threads << ')';
+      }
+
+      const std::string procBind = getProcBind(props);
+      if (procBind.size()) {
+        if (threads) {
+          ss << ' ';
+        }
+        ss << "proc_bind(" << procBind << ')';
+      }
+
+      return ss.str();
+    }
+
+    int kernel::getThreads(const occa::properties &props) {
+      const int threads = props.get(threadsPath, 0);
+
+      OCCA_ERROR("[openmp/threads] must be non-negative",
+                 0 <= threads);
+
+      return threads;
+    }
+
+    std::string kernel::getProcBind(const occa::properties &props) {
+      const std::string procBind = props.get<std::string>(procBindPath, "");
+
+      OCCA_ERROR("[openmp/proc_bind] must be one of: master, close, spread",
+                 (procBind.size() == 0)   ||
+                 (procBind == "master")   ||
+                 (procBind == "close")    ||
+                 (procBind == "spread"));
+
+      return procBind;
+    }
+
+    void kernel::runFromArguments(const int kArgc, const kernelArg *kArgs) const {
+      if (isBatched()) {
+        ((openmp::device*) dHandle)->addNestedLaunch(*this, handle, kArgc, kArgs);
+      } else {
+        serial::kernel::runFromArguments(kArgc, kArgs);
+      }
+    }
+
+    bool kernel::isBatched() const {
+      // Only kernels parsed with fused loop sets are safe to batch
+      return (((openmp::device*) dHandle)->isBatchingLaunches() &&
+              properties.get(fusePath, true));
     }
   }
 }
@@ -68,8 +68,8 @@ namespace occa {
 
       const std::string openmpTest = env::OCCA_DIR + "/scripts/openmpTest.cpp";
       hash_t hash = occa::hashFile(openmpTest);
-      hash ^= occa::hash(vendor_);
-      hash ^= occa::hash(compiler);
+      hash.update(&vendor_, sizeof(vendor_));
+      hash.update(compiler);
 
       const std::string srcFilename = io::cacheFile(openmpTest, "openmpTest.cpp", hash);
       const std::string binaryFilename = io::dirname(srcFilename) + "binary";
@@ -0,0 +1,127 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2014-2018 David Medina and Tim Warburton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ */
+
+#include "occa/modes/serial/copyQueue.hpp"
+#include "occa/modes/serial/device.hpp"
+
+namespace occa {
+  namespace serial {
+    copyQueue::copyQueue(const device *dev_) :
+      dev(dev_),
+      isStopping(false) {
+#if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
+      pthread_mutex_init(&mutex, NULL);
+      pthread_cond_init(&hasCopies, NULL);
+      pthread_cond_init(&isIdle, NULL);
+
+      const int error = pthread_create(&thread, NULL, worker, this);
+      OCCA_ERROR("Unable to start the async copy thread",
+                 error == 0);
+#endif
+    }
+
+    copyQueue::~copyQueue() {
+#if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
+      pthread_mutex_lock(&mutex);
+      isStopping = true;
+      pthread_cond_signal(&hasCopies);
+      pthread_mutex_unlock(&mutex);
+
+      pthread_join(thread, NULL);
+
+      pthread_cond_destroy(&isIdle);
+      pthread_cond_destroy(&hasCopies);
+      pthread_mutex_destroy(&mutex);
+#endif
+    }
+
+#if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
+    void* copyQueue::worker(void *args) {
+      copyQueue &queue = *((copyQueue*) args);
+
+      pthread_mutex_lock(&queue.mutex);
+      while (true) {
+        while (queue.copies.empty() && !queue.isStopping) {
+          pthread_cond_wait(&queue.hasCopies, &queue.mutex);
+        }
+        // Drain pending copies before stopping
+        if (queue.copies.empty()) {
+          break;
+        }
+        asyncCopy copy = queue.copies.front();
+        pthread_mutex_unlock(&queue.mutex);
+
+        const double startTime = sys::currentTime();
+        queue.dev->bulkCopy(copy.dest, copy.src, copy.bytes, copy.nonTemporal);
+        if (copy.isTransfer) {
+          queue.dev->finishTransfer(copy.bytes, startTime);
+        }
+
+        pthread_mutex_lock(&queue.mutex);
+        queue.copies.pop();
+        if (queue.copies.empty()) {
+          pthread_cond_broadcast(&queue.isIdle);
+        }
+      }
+      pthread_mutex_unlock(&queue.mutex);
+
+      return NULL;
+    }
+#endif
+
+    void copyQueue::push(void *dest,
+                         const void *src,
+                         const udim_t bytes,
+                         const bool nonTemporal,
+                         const bool isTransfer) {
+#if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
+      asyncCopy copy;
+      copy.dest        = dest;
+      copy.src         = src;
+      copy.bytes       = bytes;
+      copy.nonTemporal = nonTemporal;
+      copy.isTransfer  = isTransfer;
+
+      pthread_mutex_lock(&mutex);
+      copies.push(copy);
+      pthread_cond_signal(&hasCopies);
+      pthread_mutex_unlock(&mutex);
+#else
+      const double startTime = sys::currentTime();
+      dev->bulkCopy(dest, src, bytes, nonTemporal);
+      if (isTransfer) {
+        dev->finishTransfer(bytes, startTime);
+      }
+#endif
+    }
+
+    void copyQueue::finish() {
+#if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
+      pthread_mutex_lock(&mutex);
+      while (!copies.empty()) {
+        pthread_cond_wait(&isIdle, &mutex);
+      }
+      pthread_mutex_unlock(&mutex);
+#endif
+    }
+  }
+}
@@ -20,6 +20,7 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
  */
 
+#include "occa/modes/serial/copyQueue.hpp"
 #include "occa/modes/serial/device.hpp"
 #include "occa/modes/serial/kernel.hpp"
 #include "occa/modes/serial/memory.hpp"
@@ -30,8 +31,18 @@
 
 namespace occa {
   namespace serial {
+    namespace {
+      const occa::properties::path hugepagesPath("hugepages");
+      const occa::properties::path numaPath("numa");
+      const occa::properties::path firstTouchPath("first-touch");
+      const occa::properties::path mappingPath("mapping");
+      const occa::properties::path nonTemporalPath("non-temporal");
+      const occa::properties::path asyncPath("async");
+    }
+
     device::device(const occa::properties &properties_) :
-      occa::device_v(properties_) {
+      occa::device_v(properties_),
+      copies(NULL) {
 
       int vendor;
       std::string compiler, compilerFlags, compilerEnvScript;
@@ -105,11 +116,19 @@ namespace occa {
       properties["kernel/compiler"]          = compiler;
       properties["kernel/compilerFlags"]     = compilerFlags;
       properties["kernel/compilerEnvScript"] = compilerEnvScript;
+
+      if (properties.get("perf-counters", false)) {
+        OCCA_WARNING("Unable to open hardware counters for [perf-counters]"
+                     " (not on Linux or perf_event_paranoid > 2?)",
+                     kernelStats.enablePerfCounters());
+      }
     }
 
     device::~device() {}
 
-    void device::finish() const {}
+    void device::finish() const {
+      finishCopies();
+    }
 
     bool device::hasSeparateMemorySpace() const {
       return false;
@@ -122,7 +141,9 @@ namespace occa {
       return hash_;
     }
 
-    void device::waitFor(streamTag tag) const {}
+    void device::waitFor(streamTag tag) const {
+      finishCopies();
+    }
 
     stream_t device::createStream() const {
       return NULL;
@@ -170,19 +191,124 @@ namespace occa {
 
       mem->dHandle = this;
       mem->size    = bytes;
-      mem->ptr     = (char*) sys::malloc(bytes);
 
-      if (src != NULL) {
+      // [hugepages] is true or 'transparent'
+      bool hugepages = false, transparentHugepages = false;
+      if (props.has(hugepagesPath)) {
+        const json &hugepagesProp = props[hugepagesPath];
+
+        if (hugepagesProp.isString()) {
+          OCCA_ERROR("[memory/hugepages] must be true, false or 'transparent'",
+                     hugepagesProp.string() == "transparent");
+          transparentHugepages = true;
+        } else {
+          hugepages = (bool) hugepagesProp;
+        }
+      }
+      const bool hasNumaPolicy = props.has(numaPath);
+
+      if (hugepages || transparentHugepages || hasNumaPolicy) {
+        mem->ptr = (char*) sys::mallocPages(bytes,
+                                            hugepages,
+                                            transparentHugepages,
+                                            mem->mappedBytes);
+        if (hasNumaPolicy) {
+          sys::setNumaPolicy(mem->ptr,
+                             mem->mappedBytes,
+                             props[numaPath].string());
+        }
+      } else {
+        mem->ptr = (char*) sys::malloc(bytes);
+      }
+
+      if (props.get(firstTouchPath, false)) {
+        firstTouch(mem->ptr, src, bytes);
+      } else if (src != NULL) {
         ::memcpy(mem->ptr, src, bytes);
       }
 
       return mem;
     }
 
+    memory_v* device::mmap(const std::string &filename,
+                           const udim_t offset,
+                           const udim_t bytes,
+                           const occa::properties &props) {
+      memory *mem = new memory(props);
+
+      mem->dHandle = this;
+      mem->size    = bytes;
+      mem->ptr     = (char*) sys::mmapFile(filename,
+                                           offset,
+                                           bytes,
+                                           props.get<std::string>(mappingPath, "private"),
+                                           mem->mappedOffset,
+                                           mem->mappedBytes);
+      return mem;
+    }
+
+    void device::copyBytes(void *dest,
+                           const void *src,
+                           const udim_t bytes,
+                           const occa::properties &props,
+                           const bool isTransfer) const {
+      const bool nonTemporal = props.get(nonTemporalPath, false);
+
+      if (props.get(asyncPath, false)) {
+        if (copies == NULL) {
+          copies = new copyQueue(this);
+        }
+        copies->push(dest, src, bytes, nonTemporal, isTransfer);
+        return;
+      }
+
+      finishCopies();
+
+      const double startTime = (isTransfer ? sys::currentTime() : 0);
+      bulkCopy(dest, src, bytes, nonTemporal);
+      if (isTransfer) {
+        finishTransfer(bytes, startTime);
+      }
+    }
+
+    void device::bulkCopy(void *dest,
+                          const void *src,
+                          const udim_t bytes,
+                          const bool nonTemporal) const {
+      if (nonTemporal) {
+        sys::nonTemporalMemcpy(dest, src, bytes);
+      } else {
+        ::memcpy(dest, src, bytes);
+      }
+    }
+
+    void device::finishTransfer(const udim_t,
+                                const double) const {}
+
+    void device::finishCopies() const {
+      if (copies) {
+        copies->finish();
+      }
+    }
+
+    void device::firstTouch(char *ptr,
+                            const void *src,
+                            const udim_t bytes) {
+      if (src != NULL) {
+        ::memcpy(ptr, src, bytes);
+      } else {
+        ::memset(ptr, 0, bytes);
+      }
+    }
+
     udim_t device::memorySize() const {
       return sys::installedRAM();
     }
 
-    void device::free() {}
+    void device::free() {
+      // Waits for queued copies
+      delete copies;
+      copies = NULL;
+    }
   }
 }
@@ -20,13 +20,21 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
  */
 
+#include "occa/modes/serial/device.hpp"
 #include "occa/modes/serial/kernel.hpp"
 #include "occa/tools/env.hpp"
 #include "occa/tools/io.hpp"
+#include "occa/tools/trace.hpp"
 #include "occa/base.hpp"
 
 namespace occa {
   namespace serial {
+    namespace {
+      const occa::properties::path launchKernelPath("defines/OCCA_LAUNCH_KERNEL");
+      const occa::properties::path verbosePath("verbose");
+      const occa::properties::path oklPath("OKL");
+    }
+
     kernel::kernel(const occa::properties &properties_) :
       occa::kernel_v(properties_) {
       dlHandle = NULL;
@@ -41,8 +49,8 @@ namespace occa {
 
       name = kernelName;
 
-      const bool isLaunchKernel = properties.has("defines/OCCA_LAUNCH_KERNEL");
-      const bool verbose = properties.get("verbose", false);
+      const bool isLaunchKernel = properties.has(launchKernelPath);
+      const bool verbose = properties.get(verbosePath, false);
 
       const std::string sourceFile = (isLaunchKernel
                                       ? getLaunchSourceFilename(filename, hash)
@@ -129,17 +137,23 @@ namespace occa {
         std::cout << "Compiling [" << kernelName << "]\n" << sCommand << "\n";
       }
 
+      int compileError;
+      {
+        trace::scope compileScope("build", "compile");
+        compileScope.addArg("kernel", kernelName);
 #if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
-      const int compileError = system(sCommand.c_str());
+        compileError = system(sCommand.c_str());
 #else
-      const int compileError = system(("\"" +  sCommand + "\"").c_str());
+        compileError = system(("\"" +  sCommand + "\"").c_str());
 #endif
+      }
 
       if (compileError) {
         io::releaseHash(hash, hashTag);
         OCCA_ERROR("Compilation error", compileError);
       }
 
+      trace::scope dlopenScope("build", "dlopen");
       dlHandle = sys::dlopen(binaryFile, hash, hashTag);
       handle   = sys::dlsym(dlHandle, kernelName, hash, hashTag);
 
@@ -151,6 +165,7 @@ namespace occa {
 
       name = kernelName;
 
+      trace::scope dlopenScope("build", "dlopen");
       dlHandle = sys::dlopen(filename);
       handle   = sys::dlsym(dlHandle, kernelName);
     }
@@ -171,7 +186,10 @@ namespace occa {
       int argc = 0;
       kernelInfoArg_t info;
 
-      if (properties.get("OKL", true)) {
+      // Launches are ordered after async copies
+      ((serial::device*) dHandle)->finishCopies();
+
+      if (properties.get(oklPath, true)) {
         info.outerDim0 = outer.x; info.innerDim0 = inner.x;
         info.outerDim1 = outer.y; info.innerDim1 = inner.y;
         info.outerDim2 = outer.z; info.innerDim2 = inner.z;
@@ -20,6 +20,7 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
  */
 
+#include "occa/modes/serial/device.hpp"
 #include "occa/modes/serial/memory.hpp"
 #include "occa/tools/sys.hpp"
 #include "occa/device.hpp"
@@ -27,7 +28,9 @@
 namespace occa {
   namespace serial {
     memory::memory(const occa::properties &properties_) :
-      occa::memory_v(properties_) {}
+      occa::memory_v(properties_),
+      mappedOffset(0),
+      mappedBytes(0) {}
 
     memory::~memory() {}
 
@@ -44,6 +47,19 @@ namespace occa {
       return kernelArg(arg);
     }
 
+    kernelArg memory::makeOffsetKernelArg(const udim_t offset) const {
+      kernelArgData arg;
+
+      arg.dHandle = dHandle;
+      arg.mHandle = const_cast<memory*>(this);
+
+      arg.data.void_ = ptr + offset;
+      arg.size       = sizeof(void*);
+      arg.info       = kArgInfo::usePointer;
+
+      return kernelArg(arg);
+    }
+
     memory_v* memory::addOffset(const dim_t offset, bool &needsFree) {
       memory *m = new memory(properties);
       m->ptr = ptr + offset;
@@ -57,7 +73,7 @@ namespace occa {
                         const occa::properties &props) const {
       const void *srcPtr = ptr + offset;
 
-      ::memcpy(dest, srcPtr, bytes);
+      ((serial::device*) dHandle)->copyBytes(dest, srcPtr, bytes, props, true);
     }
 
     void memory::copyFrom(const void *src,
@@ -68,7 +84,7 @@ namespace occa {
       void *destPtr      = ptr + offset;
       const void *srcPtr = src;
 
-      ::memcpy(destPtr, srcPtr, bytes);
+      ((serial::device*) dHandle)->copyBytes(destPtr, srcPtr, bytes, props, true);
     }
 
     void memory::copyFrom(const memory_v *src,
@@ -80,20 +96,38 @@ namespace occa {
       void *destPtr      = ptr + destOffset;
       const void *srcPtr = src->ptr + srcOffset;
 
-      ::memcpy(destPtr, srcPtr, bytes);
+      ((serial::device*) dHandle)->copyBytes(destPtr, srcPtr, bytes, props);
+    }
+
+    // Queued async copies keep raw pointers into the memory, wait for
+    //   them before the memory is freed or handed back to a pool
+    void memory::finishCopies() const {
+      if (dHandle) {
+        ((serial::device*) dHandle)->finishCopies();
+      }
     }
 
     void memory::free() {
+      finishCopies();
       if (ptr) {
-        sys::free(ptr);
+        if (mappedBytes) {
+          sys::freePages(ptr - mappedOffset, mappedBytes);
+        } else {
+          sys::free(ptr);
+        }
         ptr = NULL;
         size = 0;
+        mappedOffset = 0;
+        mappedBytes  = 0;
       }
     }
 
     void memory::detach() {
+      finishCopies();
       ptr = NULL;
       size = 0;
+      mappedOffset = 0;
+      mappedBytes  = 0;
     }
   }
 }
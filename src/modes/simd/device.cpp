@@ -0,0 +1,47 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2014-2018 David Medina and Tim Warburton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ */
+
+#include "occa/modes/simd/device.hpp"
+#include "occa/modes/simd/kernel.hpp"
+#include "occa/modes/simd/utils.hpp"
+
+namespace occa {
+  namespace simd {
+    device::device(const occa::properties &properties_) :
+      serial::device(properties_) {
+
+      std::string &compilerFlags = properties["kernel/compilerFlags"].string();
+      compilerFlags = simd::compilerFlags(properties.get<int>("kernel/vendor"),
+                                          compilerFlags);
+    }
+
+    kernel_v* device::buildKernel(const std::string &filename,
+                                  const std::string &kernelName,
+                                  const hash_t kernelHash,
+                                  const occa::properties &props) {
+      kernel *k = new kernel(props);
+      k->setDHandle(this);
+      k->build(filename, kernelName, kernelHash);
+      return k;
+    }
+  }
+}
@@ -0,0 +1,57 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2014-2018 David Medina and Tim Warburton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ */
+
+#include "occa/modes/simd/utils.hpp"
+#include "occa/tools/sys.hpp"
+
+namespace occa {
+  namespace simd {
+    // Inner loops are only mapped to SIMD lanes when the compiler
+    //   honors [omp simd] and optimizes for the host ISA
+    std::string compilerFlags(const int vendor_,
+                              const std::string &baseFlags) {
+      std::string flags = baseFlags;
+
+      if (vendor_ & (sys::vendor::GNU |
+                     sys::vendor::LLVM)) {
+        if (flags.find("-O") == std::string::npos) {
+          flags += " -O3";
+        }
+        if (flags.find("-march") == std::string::npos) {
+          flags += " -march=native";
+        }
+        flags += " -fopenmp-simd";
+      } else if (vendor_ & sys::vendor::Intel) {
+        if (flags.find("-O") == std::string::npos) {
+          flags += " -O3";
+        }
+        if ((flags.find("-xHost") == std::string::npos) &&
+            (flags.find("-march") == std::string::npos)) {
+          flags += " -xHost";
+        }
+        flags += " -qopenmp-simd";
+      }
+
+      return flags;
+    }
+  }
+}
@@ -102,6 +102,8 @@ namespace occa {
     device::~device() {}
 
     void device::finish() const {
+      finishCopies();
+
       bool done = false;
       while (!done) {
         done = true;
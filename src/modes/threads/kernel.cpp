@@ -38,6 +38,9 @@ namespace occa {
     void kernel::runFromArguments(const int kArgc, const kernelArg *kArgs) const {
       job_t job;
 
+      // Launches are ordered after async copies
+      ((threads::device*) dHandle)->finishCopies();
+
       job.count  = threads;
       job.handle = handle;
       job.inner  = inner;
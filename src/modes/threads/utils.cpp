@@ -21,6 +21,7 @@
  */
 
 #include "occa/tools/sys.hpp"
+#include "occa/tools/trace.hpp"
 #include "occa/modes/serial/kernel.hpp"
 #include "occa/modes/threads/utils.hpp"
 
@@ -87,6 +88,9 @@ namespace occa {
     }
 
     void run(job_t &job) {
+      trace::scope traceScope("launch", "worker");
+      traceScope.addArg("rank", job.rank);
+
       handleFunction_t tmpKernel = (handleFunction_t) job.handle;
 
       int dp           = job.dims - 1;
@@ -55,6 +55,10 @@ namespace occa {
       parsingLanguage = parserInfo::parsingC;
 
       macrosAreInitialized = false;
+      _vectorizeInnerLoops = false;
+      _fuseOuterLoopSets   = false;
+      _outerForCollapse    = 1;
+      _scalarizeExclusives = false;
 
       globalScope       = new statement(*this);
       globalScope->info = smntType::namespaceStatement;
@@ -123,6 +127,10 @@ namespace occa {
 
       applyToAllKernels(*globalScope, &parserBase::floatSharedAndExclusivesUp);
 
+      if (scalarizeExclusives()) {
+        applyToAllStatements(*globalScope, &parserBase::scalarizeExclusiveVariables);
+      }
+
       // [-] Missing
       modifyTextureVariables();
 
@@ -132,6 +140,10 @@ namespace occa {
 
       loadKernelInfos();
 
+      if (vectorizeInnerLoops()) {
+        applyToAllStatements(*globalScope, &parserBase::markSimdInnerFors);
+      }
+
       applyToAllStatements(*globalScope, &parserBase::modifyExclusiveVariables);
 
       return (std::string) *globalScope;
@@ -143,8 +155,28 @@ namespace occa {
 
       const std::string &mode = properties["mode"];
       _compilingForCPU = ((mode == "Serial")   ||
+                          (mode == "Emulated") ||
                           (mode == "Pthreads") ||
-                          (mode == "OpenMP"));
+                          (mode == "OpenMP")   ||
+                          (mode == "SIMD"));
+
+      _vectorizeInnerLoops = (mode == "SIMD");
+      _fuseOuterLoopSets   = ((mode == "OpenMP") &&
+                              properties.get("openmp/fuse", true));
+      _outerForCollapse    = ((mode == "OpenMP")
+                              ? properties.get("openmp/collapse", 1)
+                              : 1);
+
+      OCCA_ERROR("[openmp/collapse] must be in [1, 3]",
+                 (1 <= _outerForCollapse) && (_outerForCollapse <= 3));
+
+      // Inner loops run sequentially per outer iteration on the CPU
+      _scalarizeExclusives = (((mode == "Serial")   ||
+                               (mode == "Emulated") ||
+                               (mode == "Threads")  ||
+                               (mode == "OpenMP")   ||
+                               (mode == "SIMD"))    &&
+                              properties.get("parser/scalarize-exclusives", true));
 
       _warnForConditionalBarriers  = properties.get("parser/warn-for-conditional-barriers", false);
       _insertBarriersAutomatically = properties.get("parser/automate-add-barriers"        , true);
@@ -155,6 +187,22 @@ namespace occa {
       // return _compilingForCPU;
     }
 
+    bool parserBase::vectorizeInnerLoops() {
+      return _vectorizeInnerLoops;
+    }
+
+    bool parserBase::fuseOuterLoopSets() {
+      return _fuseOuterLoopSets;
+    }
+
+    int parserBase::outerForCollapse() {
+      return _outerForCollapse;
+    }
+
+    bool parserBase::scalarizeExclusives() {
+      return _scalarizeExclusives;
+    }
+
     bool parserBase::warnForConditionalBarriers() {
       return _warnForConditionalBarriers;
     }
@@ -753,7 +801,11 @@ namespace occa {
       std::string modes[5] = {
         "SERIAL", "OPENMP", "OPENCL", "CUDA", "PTHREADS",
       };
-      const std::string currentMode = uppercase(properties["mode"].string());
+      std::string currentMode = uppercase(properties["mode"].string());
+      // Emulated devices run Serial kernels
+      if (currentMode == "EMULATED") {
+        currentMode = "SERIAL";
+      }
       for (int i = 0; i < 5; ++i) {
         std::string modeDefine = "#define OCCA_USING_";
         modeDefine += modes[i];
@@ -2217,6 +2269,14 @@ namespace occa {
         statement &s2  = *(statementPos->value);
         statement *sUp = s2.up;
 
+        // Already thread-local, no need to keep it around
+        if (exclusiveIsInInnerFor(s2)) {
+          removeExclusiveQualifiers(s2);
+
+          statementPos = statementPos->right;
+          continue;
+        }
+
         // We're moving the definition else-where
         if (sUp) {
           varInfo &var = s2.getDeclarationVarInfo(0);
@@ -2306,6 +2366,197 @@ namespace occa {
       return snTail;
     }
 
+    bool parserBase::exclusiveIsInInnerFor(statement &s) {
+      // Exclusives declared in the inner-most loop body are only
+      //   seen by one thread on the CPU
+      return (scalarizeExclusives()                    &&
+              s.hasQualifier("exclusive")              &&
+              s.up                                     &&
+              statementIsOccaInnerFor(*(s.up))         &&
+              (s.up->expRoot.value == "occaInnerFor0") &&
+              (getStatementKernel(s) != NULL)          &&
+              !statementKernelUsesNativeOCCA(s));
+    }
+
+    void parserBase::removeExclusiveQualifiers(statement &s) {
+      const int argc = s.getDeclarationVarCount();
+
+      for (int i = 0; i < argc; ++i)
+        s.getDeclarationVarInfo(i).removeQualifier("exclusive");
+    }
+
+    void parserBase::scalarizeExclusiveVariables(statement &s) {
+      if ((s.info != smntType::occaFor)       ||
+          !statementIsOccaOuterFor(s)         ||
+          (getStatementKernel(s) == NULL)     ||
+          (statementKernelUsesNativeOCCA(s))) {
+
+        return;
+      }
+
+      // Find exclusives only used inside one inner-most loop
+      statementVector decls, innerFors;
+
+      statementNode *statementPos = s.statementStart;
+
+      while(statementPos) {
+        statement &s2 = *(statementPos->value);
+
+        if ((s2.info & smntType::declareStatement) &&
+            s2.hasQualifier("exclusive")) {
+
+          const int argc = s2.getDeclarationVarCount();
+          statement *sInner = NULL;
+
+          for (int i = 0; i < argc; ++i) {
+            // Moving an initializer into the inner-for changes when it's
+            //   evaluated, only constant ones can move
+            expNode *initNode = s2.getDeclarationVarInitNode(i);
+
+            if (initNode && !initNode->valueIsKnown()) {
+              sInner = NULL;
+              break;
+            }
+
+            statement *sVarInner = getExclusiveInnerFor(s, s2,
+                                                        s2.getDeclarationVarInfo(i));
+
+            if ((sVarInner == NULL) ||
+                ((sInner != NULL) && (sInner != sVarInner))) {
+              sInner = NULL;
+              break;
+            }
+
+            sInner = sVarInner;
+          }
+
+          if (sInner) {
+            decls.push_back(&s2);
+            innerFors.push_back(sInner);
+          }
+        }
+
+        statementPos = statementPos->right;
+      }
+
+      // Move them into their inner-for as plain locals, keeping their order
+      std::map<statement*, statement*> firstStatements;
+
+      for (int d = 0; d < (int) decls.size(); ++d) {
+        statement &s2     = *(decls[d]);
+        statement &sInner = *(innerFors[d]);
+
+        if (firstStatements.find(&sInner) == firstStatements.end())
+          firstStatements[&sInner] = sInner.statementStart->value;
+
+        statementNode *sn = s2.getStatementNode();
+
+        if (s.statementStart == sn)
+          s.statementStart = sn->right;
+        if (s.statementEnd == sn)
+          s.statementEnd = sn->left;
+
+        delete sn->pop();
+
+        removeExclusiveQualifiers(s2);
+
+        sInner.pushLeftOf(firstStatements[&sInner], &s2);
+
+        const int argc = s2.getDeclarationVarCount();
+
+        for (int i = 0; i < argc; ++i) {
+          varInfo &var = s2.getDeclarationVarInfo(i);
+
+          s.removeVarFromScope(var.name);
+          sInner.addVariable(&var, &s2);
+        }
+      }
+    }
+
+    statement* parserBase::getExclusiveInnerFor(statement &sOuter,
+                                                statement &sDecl,
+                                                varInfo &var) {
+      statementVector uses;
+      findVarUses(sOuter, sDecl, var, uses);
+
+      statement *sInner = NULL;
+
+      for (int i = 0; i < (int) uses.size(); ++i) {
+        statement *sUseInner = getThreadLocalInnerFor(*(uses[i]), sOuter);
+
+        if ((sUseInner == NULL) ||
+            ((sInner != NULL) && (sInner != sUseInner))) {
+          return NULL;
+        }
+
+        sInner = sUseInner;
+      }
+
+      // Don't shadow an inner-for variable
+      if (sInner &&
+          sInner->hasVariableInLocalScope(var.name)) {
+        return NULL;
+      }
+
+      return sInner;
+    }
+
+    void parserBase::findVarUses(statement &s,
+                                 statement &sDecl,
+                                 varInfo &var,
+                                 statementVector &uses) {
+      if (&s == &sDecl)
+        return;
+
+      expNode &flatRoot = *(s.expRoot.makeFlatHandle());
+
+      for (int i = 0; i < flatRoot.leafCount; ++i) {
+        if ((flatRoot[i].info & expType::varInfo) &&
+            (&(flatRoot[i].getVarInfo()) == &var)) {
+
+          uses.push_back(&s);
+          break;
+        }
+      }
+
+      expNode::freeFlatHandle(flatRoot);
+
+      statementNode *statementPos = s.statementStart;
+
+      while(statementPos) {
+        findVarUses(*(statementPos->value), sDecl, var, uses);
+        statementPos = statementPos->right;
+      }
+    }
+
+    statement* parserBase::getThreadLocalInnerFor(statement &s,
+                                                  statement &sOuter) {
+      // A thread runs the inner-most inner-for body once, unless another
+      //   loop wraps the inner-for
+      statement *sInner = NULL;
+      statement *sUp    = &s;
+
+      while(sUp && (sUp != &sOuter)) {
+        if (statementIsOccaInnerFor(*sUp)) {
+          if (sInner == NULL) {
+            if (sUp->expRoot.value != "occaInnerFor0")
+              return NULL;
+
+            sInner = sUp;
+          }
+        }
+        else if (sInner &&
+                 (sUp->info & (smntType::forStatement |
+                               smntType::whileStatement))) {
+          return NULL;
+        }
+
+        sUp = sUp->up;
+      }
+
+      return sInner;
+    }
+
     void parserBase::modifyExclusiveVariables(statement &s) {
       if ( !(s.info & smntType::declareStatement)   ||
            (getStatementKernel(s) == NULL)    ||
@@ -2417,6 +2668,75 @@ namespace occa {
       s.statementStart = s.statementEnd = NULL;
     }
 
+    void parserBase::markSimdInnerFors(statement &s) {
+      if ((s.info != smntType::occaFor)          ||
+          (s.expRoot.value != "occaInnerFor0")   ||
+          (getStatementKernel(s) == NULL)        ||
+          (statementKernelUsesNativeOCCA(s))     ||
+          !innerForIsVectorizable(s)) {
+
+        return;
+      }
+
+      // Exclusives are floated up to the inner-most outer-for and keep
+      //   references to the inner ids, which [omp simd] privatizes
+      statement *sUp = s.up;
+
+      while(sUp && !statementIsOccaOuterFor(*sUp))
+        sUp = sUp->up;
+
+      if (sUp == NULL)
+        return;
+
+      statementNode *statementPos = sUp->statementStart;
+
+      while(statementPos) {
+        statement &s2 = *(statementPos->value);
+
+        if ((s2.info & smntType::declareStatement) &&
+            s2.hasQualifier("exclusive")) {
+
+          return;
+        }
+
+        statementPos = statementPos->right;
+      }
+
+      s.expRoot.value = "occaSimdInnerFor0";
+    }
+
+    bool parserBase::innerForIsVectorizable(statement &s) {
+      // Lanes can't exit early or race on atomics
+      expNode &flatRoot = *(s.expRoot.makeFlatHandle());
+      bool isVectorizable = true;
+
+      for (int i = -1; i < flatRoot.leafCount; ++i) {
+        const std::string &value = ((i < 0)
+                                    ? s.expRoot.value
+                                    : flatRoot[i].value);
+
+        if ((value == "return") ||
+            (value == "break")  ||
+            (value == "goto")   ||
+            startsWith(value, "occaAtomic")) {
+
+          isVectorizable = false;
+          break;
+        }
+      }
+
+      expNode::freeFlatHandle(flatRoot);
+
+      statementNode *statementPos = s.statementStart;
+
+      while(isVectorizable && statementPos) {
+        isVectorizable = innerForIsVectorizable(*(statementPos->value));
+        statementPos = statementPos->right;
+      }
+
+      return isVectorizable;
+    }
+
     // [-] Missing
     void parserBase::modifyTextureVariables() {
       /*
@@ -2704,13 +3024,67 @@ namespace occa {
         //   outer-most-loop <--> host kernel
         statement::swapPlaces(omLoop, sLaunch);
 
+        std::string parallelFor = (fuseOuterLoopSets()
+                                   ? "occaFusedFor"
+                                   : "occaParallelFor");
+        parallelFor += ('0' + collapseOuterFors(omLoop) - 1);
+
         newSKernel.pushSourceLeftOf(omLoop.getStatementNode(),
-                                    "occaParallelFor0");
+                                    parallelFor);
       }
 
       return newKernels;
     }
 
+    int parserBase::collapseOuterFors(statement &omLoop) {
+      int collapsed = 1;
+      statement *sOuter = &omLoop;
+
+      while(collapsed < outerForCollapse()) {
+        // Only iterator setups can be between collapsed loops
+        statement *sNext = NULL;
+        bool isPerfectlyNested = true;
+
+        statementNode *statementPos = sOuter->statementStart;
+
+        while(statementPos) {
+          statement &s2 = *(statementPos->value);
+
+          if ((sNext == NULL) && statementIsOccaOuterFor(s2)) {
+            sNext = &s2;
+          }
+          else if ((sNext != NULL) ||
+                   !s2.hasAttribute("isAnOccaIterExp")) {
+            isPerfectlyNested = false;
+            break;
+          }
+
+          statementPos = statementPos->right;
+        }
+
+        if (!isPerfectlyNested || (sNext == NULL))
+          break;
+
+        // Sink the iterator setups into the next loop
+        statement *sFirst = sNext->statementStart->value;
+
+        while(sOuter->statementStart->value != sNext) {
+          statementNode *sn = sOuter->statementStart;
+          statement &s2     = *(sn->value);
+
+          sOuter->statementStart = sn->right;
+          delete sn->pop();
+
+          sNext->pushLeftOf(sFirst, &s2);
+        }
+
+        sOuter = sNext;
+        ++collapsed;
+      }
+
+      return collapsed;
+    }
+
     void parserBase::addDepStatementsToKernel(statement &sKernel,
                                               varOriginMap_t &deps) {
 
@@ -4159,6 +4533,9 @@ namespace occa {
       cKeywordType["occaParallelFor0"]   = expType::specialKeyword;
       cKeywordType["occaParallelFor1"]   = expType::specialKeyword;
       cKeywordType["occaParallelFor2"]   = expType::specialKeyword;
+      cKeywordType["occaFusedFor0"]      = expType::specialKeyword;
+      cKeywordType["occaFusedFor1"]      = expType::specialKeyword;
+      cKeywordType["occaFusedFor2"]      = expType::specialKeyword;
 
       cKeywordType["occaUnroll"]         = expType::specialKeyword;
 
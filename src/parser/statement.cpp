@@ -319,10 +319,12 @@ namespace occa {
           return;
         }
 
-        // [occaParallelFor][#]
-        // 15              + 1 = 16
-        if ((firstValue.find("occaParallelFor") != std::string::npos) &&
-            (firstValue.size() == 16)) {
+        // [occaParallelFor][#] or [occaFusedFor][#]
+        // 15              + 1 = 16, 12 + 1 = 13
+        if (((firstValue.find("occaParallelFor") != std::string::npos) &&
+             (firstValue.size() == 16)) ||
+            ((firstValue.find("occaFusedFor") != std::string::npos) &&
+             (firstValue.size() == 13))) {
 
           sInfo->info = smntType::macroStatement;
           info        = expType::printValue;
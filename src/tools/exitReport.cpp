@@ -0,0 +1,93 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2014-2018 David Medina and Tim Warburton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ */
+
+#include <cstdlib>
+#include <map>
+#include <vector>
+
+#include "occa/tools/env.hpp"
+#include "occa/tools/exitReport.hpp"
+
+namespace occa {
+  namespace {
+    std::map<std::string, exitReport*>& reports() {
+      static std::map<std::string, exitReport*> *reports_ = new std::map<std::string, exitReport*>();
+      return *reports_;
+    }
+
+    // Enabled reports in the order they were first requested
+    std::vector<exitReport*>& enabledReports() {
+      static std::vector<exitReport*> *reports_ = new std::vector<exitReport*>();
+      return *reports_;
+    }
+
+    void printEnabledReports() {
+      std::vector<exitReport*> &reports_ = enabledReports();
+      const int reportCount = (int) reports_.size();
+      for (int i = 0; i < reportCount; ++i) {
+        reports_[i]->printAll();
+      }
+    }
+  }
+
+  exitReporter::~exitReporter() {}
+
+  exitReport::exitReport(const std::string &envVar) :
+    enabled(env::get<bool>(envVar, false)) {
+    if (!enabled) {
+      return;
+    }
+    if (enabledReports().size() == 0) {
+      std::atexit(printEnabledReports);
+    }
+    enabledReports().push_back(this);
+  }
+
+  exitReport& exitReport::get(const std::string &envVar) {
+    exitReport *&report = reports()[envVar];
+    if (report == NULL) {
+      report = new exitReport(envVar);
+    }
+    return *report;
+  }
+
+  void exitReport::add(exitReporter *reporter) {
+    if (enabled) {
+      reporters.insert(reporter);
+    }
+  }
+
+  void exitReport::remove(exitReporter *reporter) {
+    if (reporters.erase(reporter)) {
+      reporter->printExitReport();
+    }
+  }
+
+  void exitReport::printAll() {
+    std::set<exitReporter*>::iterator it = reporters.begin();
+    while (it != reporters.end()) {
+      (*it)->printExitReport();
+      ++it;
+    }
+    reporters.clear();
+  }
+}
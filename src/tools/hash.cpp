@@ -20,6 +20,8 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
  */
 
+#include <cstdio>
+#include <cstring>
 #include <sstream>
 #include <stdint.h>
 
@@ -29,6 +31,144 @@
 #include "occa/tools/io.hpp"
 
 namespace occa {
+  //---[ Block Hash ]-------------------
+  namespace {
+    const uint64_t prime1 = 11400714785074694791ULL;
+    const uint64_t prime2 = 14029467366897019727ULL;
+    const uint64_t prime3 = 1609587929392839161ULL;
+    const uint64_t prime4 = 9650029242287828579ULL;
+    const uint64_t prime5 = 2870177450012600261ULL;
+
+    inline uint64_t rotl(const uint64_t x, const int r) {
+      return ((x << r) | (x >> (64 - r)));
+    }
+
+    inline uint64_t read64(const unsigned char *c) {
+      uint64_t value;
+      ::memcpy(&value, c, sizeof(value));
+      return value;
+    }
+
+    inline uint64_t read32(const unsigned char *c) {
+      uint32_t value;
+      ::memcpy(&value, c, sizeof(value));
+      return value;
+    }
+
+    inline uint64_t laneRound(uint64_t lane, const uint64_t input) {
+      lane += input * prime2;
+      lane  = rotl(lane, 31);
+      return lane * prime1;
+    }
+
+    inline uint64_t mergeRound(uint64_t h, const uint64_t lane) {
+      h ^= laneRound(0, lane);
+      return (h * prime1) + prime4;
+    }
+
+    inline void hashStripe(uint64_t *lanes, const unsigned char *c) {
+      lanes[0] = laneRound(lanes[0], read64(c));
+      lanes[1] = laneRound(lanes[1], read64(c + 8));
+      lanes[2] = laneRound(lanes[2], read64(c + 16));
+      lanes[3] = laneRound(lanes[3], read64(c + 24));
+    }
+
+    void startStream(hash_t &hash) {
+      hash.lanes[0] = prime1 + prime2;
+      hash.lanes[1] = prime2;
+      hash.lanes[2] = 0;
+      hash.lanes[3] = -prime1;
+      hash.stripeBytes = 0;
+      hash.totalBytes  = 0;
+      hash.isStreaming = true;
+    }
+
+    void absorb(hash_t &hash,
+                const unsigned char *c,
+                udim_t bytes) {
+      hash.totalBytes += bytes;
+
+      // Finish a partial stripe from the last update
+      if (hash.stripeBytes) {
+        const int fill = ((bytes < (udim_t) (32 - hash.stripeBytes))
+                          ? (int) bytes
+                          : (32 - hash.stripeBytes));
+        ::memcpy(hash.stripe + hash.stripeBytes, c, fill);
+        hash.stripeBytes += fill;
+        c     += fill;
+        bytes -= fill;
+        if (hash.stripeBytes < 32) {
+          return;
+        }
+        hashStripe(hash.lanes, hash.stripe);
+        hash.stripeBytes = 0;
+      }
+
+      while (bytes >= 32) {
+        hashStripe(hash.lanes, c);
+        c     += 32;
+        bytes -= 32;
+      }
+
+      if (bytes) {
+        ::memcpy(hash.stripe, c, bytes);
+        hash.stripeBytes = (int) bytes;
+      }
+    }
+
+    // Each 64-bit word merges every lane and the tail with its own seed
+    void finalize(hash_t &hash) {
+      const uint64_t *lanes = hash.lanes;
+      for (int w = 0; w < 4; ++w) {
+        const uint64_t seed = w * prime3;
+        uint64_t h;
+        if (hash.totalBytes >= 32) {
+          h = (rotl(lanes[0], 1 + w)
+               + rotl(lanes[1], 7 + w)
+               + rotl(lanes[2], 12 + w)
+               + rotl(lanes[3], 18 + w)
+               + seed);
+          h = mergeRound(h, lanes[0]);
+          h = mergeRound(h, lanes[1]);
+          h = mergeRound(h, lanes[2]);
+          h = mergeRound(h, lanes[3]);
+        } else {
+          h = seed + prime5;
+        }
+        h += hash.totalBytes;
+
+        const unsigned char *c = hash.stripe;
+        int bytes = hash.stripeBytes;
+        for (; bytes >= 8; bytes -= 8, c += 8) {
+          h ^= laneRound(0, read64(c));
+          h  = (rotl(h, 27) * prime1) + prime4;
+        }
+        if (bytes >= 4) {
+          h ^= read32(c) * prime1;
+          h  = (rotl(h, 23) * prime2) + prime3;
+          bytes -= 4;
+          c     += 4;
+        }
+        for (; bytes > 0; --bytes, ++c) {
+          h ^= (*c) * prime5;
+          h  = rotl(h, 11) * prime1;
+        }
+
+        // Avalanche
+        h ^= (h >> 33);
+        h *= prime2;
+        h ^= (h >> 29);
+        h *= prime3;
+        h ^= (h >> 32);
+
+        hash.h[2*w    ] = (int) (uint32_t) h;
+        hash.h[2*w + 1] = (int) (uint32_t) (h >> 32);
+      }
+      hash.initialized = true;
+    }
+  }
+  //====================================
+
   hash_t::hash_t() {
     initialized = false;
     h[0] = 101527; h[1] = 101531;
@@ -38,6 +178,7 @@ namespace occa {
     for (int i = 0; i < 8; ++i) {
       sh[i] = 0;
     }
+    isStreaming = false;
   }
 
   hash_t::hash_t(const int *h_) {
@@ -48,6 +189,7 @@ namespace occa {
     for (int i = 0; i < 8; ++i) {
       sh[i] = 0;
     }
+    isStreaming = false;
   }
 
   hash_t::hash_t(const hash_t &hash) {
@@ -62,6 +204,15 @@ namespace occa {
     for (int i = 0; i < 8; ++i) {
       sh[i] = 0;
     }
+    isStreaming = hash.isStreaming;
+    if (isStreaming) {
+      for (int i = 0; i < 4; ++i) {
+        lanes[i] = hash.lanes[i];
+      }
+      stripeBytes = hash.stripeBytes;
+      totalBytes  = hash.totalBytes;
+      ::memcpy(stripe, hash.stripe, stripeBytes);
+    }
     return *this;
   }
 
@@ -69,6 +220,24 @@ namespace occa {
     *this = hash_t();
   }
 
+  hash_t& hash_t::update(const void *ptr, const udim_t bytes) {
+    if (!isStreaming) {
+      startStream(*this);
+      if (initialized) {
+        int value[8];
+        ::memcpy(value, h, sizeof(value));
+        absorb(*this, (const unsigned char*) value, sizeof(value));
+      }
+    }
+    absorb(*this, (const unsigned char*) ptr, bytes);
+    finalize(*this);
+    return *this;
+  }
+
+  hash_t& hash_t::update(const std::string &str) {
+    return update(str.c_str(), str.size());
+  }
+
   bool hash_t::operator < (const hash_t &fo) const {
     for (int i = 0; i < 8; ++i) {
       if (h[i] < fo.h[i]) {
@@ -149,24 +318,8 @@ namespace occa {
   }
 
   hash_t hash(const void *ptr, udim_t bytes) {
-    std::stringstream ss;
-    const char *c = (char*) ptr;
-
     hash_t hash;
-    int *h = hash.h;
-
-    const int p[8] = {
-      102679, 102701, 102761, 102763,
-      102769, 102793, 102797, 102811
-    };
-
-    for (udim_t i = 0; i < bytes; ++i) {
-      for (int j = 0; j < 8; ++j) {
-        h[j] = (h[j] * p[j]) ^ c[i];
-      }
-    }
-    hash.initialized = true;
-
+    hash.update(ptr, bytes);
     return hash;
   }
 
@@ -179,9 +332,20 @@ namespace occa {
   }
 
   hash_t hashFile(const std::string &filename) {
-    const char *c = io::c_read(io::filename(filename));
-    hash_t ret = hash(c);
-    ::free((void*) c);
+    const std::string expFilename = io::filename(filename);
+    FILE *fp = fopen(expFilename.c_str(), "r");
+    OCCA_ERROR("Failed to open [" << io::shortname(expFilename) << "]",
+               fp != NULL);
+
+    // Files are hashed in chunks rather than read whole
+    char buffer[16 << 10];
+    hash_t ret;
+    ret.update(NULL, 0);
+    size_t bytesRead;
+    while ((bytesRead = fread(buffer, sizeof(char), sizeof(buffer), fp)) > 0) {
+      ret.update(buffer, bytesRead);
+    }
+    fclose(fp);
     return ret;
   }
 }
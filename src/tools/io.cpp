@@ -47,6 +47,7 @@
 #include "occa/tools/io.hpp"
 #include "occa/tools/string.hpp"
 #include "occa/tools/sys.hpp"
+#include "occa/tools/trace.hpp"
 #include "occa/par/tls.hpp"
 
 namespace occa {
@@ -58,6 +59,8 @@ namespace occa {
     const std::string sourceFile       = "device-source.cpp";
     const std::string binaryFile       = "device-binary";
     const std::string infoFile         = "build-info.json";
+
+    const std::string cacheVersion     = "v1";
   }
 
   namespace io {
@@ -157,7 +160,7 @@ namespace occa {
     const std::string& cachePath() {
       static std::string path;
       if (path.size() == 0) {
-        path = env::OCCA_CACHE_DIR + "cache/";
+        path = env::OCCA_CACHE_DIR + "cache/" + kc::cacheVersion + "/";
       }
       return path;
     }
@@ -165,7 +168,7 @@ namespace occa {
     const std::string& libraryPath() {
       static std::string path;
       if (path.size() == 0) {
-        path = env::OCCA_CACHE_DIR + "libraries/";
+        path = env::OCCA_CACHE_DIR + "libraries/" + kc::cacheVersion + "/";
       }
       return path;
     }
@@ -380,6 +383,13 @@ namespace occa {
       return true;
     }
 
+    udim_t fileSize(const std::string &filename) {
+      struct stat statbuf;
+      OCCA_ERROR("Failed to open [" << io::shortname(filename) << "]",
+                 stat(filename.c_str(), &statbuf) == 0);
+      return statbuf.st_size;
+    }
+
     char* c_read(const std::string &filename,
                  size_t *chars,
                  const bool readingBinary) {
@@ -465,6 +475,9 @@ namespace occa {
 
     void waitForHash(const hash_t &hash,
                      const std::string &tag) {
+      trace::scope traceScope("cache", "lock-wait");
+      traceScope.addArg("tag", tag);
+
       struct stat buffer;
 
       std::string lockDir   = getFileLock(hash, tag);
@@ -620,7 +633,7 @@ namespace occa {
 
     std::string getLibraryName(const std::string &filename) {
       std::string expFilename = io::filename(filename);
-      const std::string cacheLibraryPath = (env::OCCA_CACHE_DIR + "libraries/");
+      const std::string &cacheLibraryPath = libraryPath();
 
       if (expFilename.find(cacheLibraryPath) != 0) {
         return "";
@@ -20,6 +20,7 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
  */
 
+#include <cstdlib>
 #include <cstring>
 
 #include "occa/defines.hpp"
@@ -27,20 +28,280 @@
 #include "occa/tools/json.hpp"
 
 namespace occa {
+  //---[ jsonValue_t ]------------------
+#if defined(__GNUC__) || defined(__clang__)
+#  define OCCA_JSON_ATOMIC_LOAD(value)             __atomic_load_n(&(value), __ATOMIC_ACQUIRE)
+#  define OCCA_JSON_ATOMIC_STORE(value, value_)     __atomic_store_n(&(value), value_, __ATOMIC_RELEASE)
+#  define OCCA_JSON_ATOMIC_ADD(value, value_)       __atomic_add_fetch(&(value), value_, __ATOMIC_ACQ_REL)
+#  define OCCA_JSON_ATOMIC_CAS(value, old_, value_) __sync_bool_compare_and_swap(&(value), old_, value_)
+#else
+#  define OCCA_JSON_ATOMIC_LOAD(value)             (value)
+#  define OCCA_JSON_ATOMIC_STORE(value, value_)     ((value) = (value_))
+#  define OCCA_JSON_ATOMIC_ADD(value, value_)       ((value) += (value_))
+#  define OCCA_JSON_ATOMIC_CAS(value, old_, value_) (((value) == (old_)) ? ((value) = (value_), true) : false)
+#endif
+
+  namespace {
+    // Containers are shared between copies and cloned by the first
+    //   non-const access while shared
+    // Leaked containers had a reference handed out and are never
+    //   shared again, similar to leaked copy-on-write strings
+    class sharedContainerBase {
+    public:
+      int refs;
+      bool leaked;
+
+      sharedContainerBase() :
+        refs(1),
+        leaked(false) {}
+    };
+
+    template <class TM>
+    class sharedContainer : public sharedContainerBase {
+    public:
+      TM value;
+
+      sharedContainer() {}
+
+      sharedContainer(const TM &value_) :
+        value(value_) {}
+    };
+
+    typedef sharedContainer<std::string> sharedString;
+    typedef sharedContainer<jsonObject>  sharedObject;
+    typedef sharedContainer<jsonArray>   sharedArray;
+
+    inline sharedContainerBase& containerBase(void *ptr) {
+      // sharedContainerBase is the only base of every sharedContainer
+      return *((sharedContainerBase*) ptr);
+    }
+
+    void* newContainer(const jsonValue_t::container_t container) {
+      switch (container) {
+      case jsonValue_t::string_: return new sharedString();
+      case jsonValue_t::object_: return new sharedObject();
+      case jsonValue_t::array_:  return new sharedArray();
+      default: return NULL;
+      }
+    }
+
+    void* cloneContainer(const jsonValue_t::container_t container,
+                         void *ptr) {
+      switch (container) {
+      case jsonValue_t::string_: return new sharedString(((sharedString*) ptr)->value);
+      case jsonValue_t::object_: return new sharedObject(((sharedObject*) ptr)->value);
+      case jsonValue_t::array_:  return new sharedArray(((sharedArray*) ptr)->value);
+      default: return NULL;
+      }
+    }
+
+    void releaseContainer(const jsonValue_t::container_t container,
+                          void *ptr) {
+      if (OCCA_JSON_ATOMIC_ADD(containerBase(ptr).refs, -1) != 0) {
+        return;
+      }
+      switch (container) {
+      case jsonValue_t::string_: delete (sharedString*) ptr; break;
+      case jsonValue_t::object_: delete (sharedObject*) ptr; break;
+      case jsonValue_t::array_:  delete (sharedArray*) ptr;  break;
+      default: ;
+      }
+    }
+  }
+
+  jsonValue_t::jsonValue_t() :
+    number(0),
+    boolean(false),
+    container(none_),
+    ptr(NULL) {}
+
+  jsonValue_t::jsonValue_t(const jsonValue_t &value) :
+    number(value.number),
+    boolean(value.boolean),
+    container(none_),
+    ptr(NULL) {
+    copyContainer(value);
+  }
+
+  jsonValue_t::~jsonValue_t() {
+    freeContainer();
+  }
+
+  jsonValue_t& jsonValue_t::operator = (const jsonValue_t &value) {
+    if (this != &value) {
+      number  = value.number;
+      boolean = value.boolean;
+      // The source can be owned by our container, e.g. j = j["key"]
+      jsonValue_t copy(value);
+      freeContainer();
+      container = copy.container;
+      ptr       = copy.ptr;
+      copy.container = none_;
+      copy.ptr       = NULL;
+    }
+    return *this;
+  }
+
+  void jsonValue_t::clear() {
+    freeContainer();
+    number  = 0;
+    boolean = false;
+  }
+
+  void jsonValue_t::useContainer(const container_t container_) {
+    if (container != container_) {
+      freeContainer();
+    }
+  }
+
+  bool jsonValue_t::isShareable() const {
+    return (ptr &&
+            !containerBase(ptr).leaked);
+  }
+
+  void jsonValue_t::freeContainer() {
+    if (ptr) {
+      releaseContainer(container, ptr);
+    }
+    container = none_;
+    ptr = NULL;
+  }
+
+  void jsonValue_t::copyContainer(const jsonValue_t &value) {
+    container = value.container;
+    ptr       = value.ptr;
+    if (!ptr) {
+      return;
+    }
+    // References into leaked containers can still modify them
+    if (containerBase(ptr).leaked) {
+      ptr = cloneContainer(container, ptr);
+    } else {
+      OCCA_JSON_ATOMIC_ADD(containerBase(ptr).refs, 1);
+    }
+  }
+
+  void* jsonValue_t::mutableContainer(const container_t container_,
+                                      const bool leak) {
+    if (container == none_) {
+      ptr = newContainer(container_);
+      container = container_;
+    }
+    static const char *containerNames[] = {
+      "", "a string", "an object", "an array"
+    };
+    OCCA_ERROR("JSON value does not hold " << containerNames[container_],
+               container == container_);
+
+    if (OCCA_JSON_ATOMIC_LOAD(containerBase(ptr).refs) > 1) {
+      void *shared = ptr;
+      ptr = cloneContainer(container, shared);
+      releaseContainer(container, shared);
+    }
+    if (leak) {
+      containerBase(ptr).leaked = true;
+    }
+    return ptr;
+  }
+
+  std::string& jsonValue_t::string() {
+    return ((sharedString*) mutableContainer(string_, true))->value;
+  }
+
+  jsonObject& jsonValue_t::object() {
+    return ((sharedObject*) mutableContainer(object_, true))->value;
+  }
+
+  jsonArray& jsonValue_t::array() {
+    return ((sharedArray*) mutableContainer(array_, true))->value;
+  }
+
+  std::string& jsonValue_t::editString() {
+    return ((sharedString*) mutableContainer(string_, false))->value;
+  }
+
+  jsonObject& jsonValue_t::editObject() {
+    return ((sharedObject*) mutableContainer(object_, false))->value;
+  }
+
+  jsonArray& jsonValue_t::editArray() {
+    return ((sharedArray*) mutableContainer(array_, false))->value;
+  }
+
+  const std::string& jsonValue_t::string() const {
+    static const std::string empty;
+    return ((container == string_)
+            ? ((const sharedString*) ptr)->value
+            : empty);
+  }
+
+  const jsonObject& jsonValue_t::object() const {
+    static const jsonObject empty;
+    return ((container == object_)
+            ? ((const sharedObject*) ptr)->value
+            : empty);
+  }
+
+  const jsonArray& jsonValue_t::array() const {
+    static const jsonArray empty;
+    return ((container == array_)
+            ? ((const sharedArray*) ptr)->value
+            : empty);
+  }
+  //====================================
+
+  //---[ jsonHashCache ]---------------
+  jsonHashCache::jsonHashCache(const jsonHashCache &other) :
+    state(unset_) {
+    hash_t hash;
+    if (other.get(hash)) {
+      ::memcpy(h, hash.h, sizeof(h));
+      state = set_;
+    }
+  }
+
+  jsonHashCache& jsonHashCache::operator = (const jsonHashCache &other) {
+    if (this != &other) {
+      hash_t hash;
+      state = unset_;
+      if (other.get(hash)) {
+        ::memcpy(h, hash.h, sizeof(h));
+        state = set_;
+      }
+    }
+    return *this;
+  }
+
+  bool jsonHashCache::get(hash_t &hash) const {
+    if (OCCA_JSON_ATOMIC_LOAD(state) != set_) {
+      return false;
+    }
+    hash = hash_t(h);
+    return true;
+  }
+
+  void jsonHashCache::set(const hash_t &hash) {
+    // Threads losing the race computed the same hash, they skip storing
+    if (OCCA_JSON_ATOMIC_CAS(state, (int) unset_, (int) storing_)) {
+      ::memcpy(h, hash.h, sizeof(h));
+      OCCA_JSON_ATOMIC_STORE(state, (int) set_);
+    }
+  }
+  //====================================
+
   const char json::objectKeyEndChars[] = " \t\r\n\v\f:";
 
   json& json::clear() {
     type = none_;
-    value_.string = "";
-    value_.number = 0;
-    value_.object.clear();
-    value_.array.clear();
-    value_.boolean = false;
+    cachedHash.clear();
+    value_.clear();
     return *this;
   }
 
   json& json::operator = (const json &j) {
+    // value_ is assigned last since [j] can be owned by it
     type = j.type;
+    cachedHash = j.cachedHash;
     value_ = j.value_;
     return *this;
   }
@@ -88,8 +349,12 @@ namespace occa {
   }
 
   json json::read(const std::string &filename) {
+    // Parse the file buffer directly instead of copying it to a string
+    const char *buffer = io::c_read(filename);
+    const char *c = buffer;
     json j;
-    j.load(io::read(filename));
+    j.load(c);
+    ::free((void*) buffer);
     return j;
   }
 
@@ -97,58 +362,104 @@ namespace occa {
     io::write(filename, toString());
   }
 
-  void json::loadString(const char *&c) {
-    // Skip quote
-    const char quote = *c;
-    ++c;
-    type = string_;
+  namespace {
+    // Appends the quoted string at [c] to [str]
+    void loadQuotedString(const char *&c, std::string &str) {
+      // Skip quote
+      const char quote = *c;
+      ++c;
 
-    while (*c != '\0') {
-      if (*c == '\\') {
-        ++c; // Skip '\'
-        OCCA_ERROR("Unclosed string",
-                   *c != '\0');
-
-        switch (*c) {
-        case 'b':  value_.string += '\b'; break;
-        case 'f':  value_.string += '\f'; break;
-        case 'n':  value_.string += '\n'; break;
-        case 'r':  value_.string += '\r'; break;
-        case 't':  value_.string += '\t'; break;
-        case 'u':
-          // Found unicode character
-          // Load \uXXXX
-          ++c; // Skip 'u'
-          value_.string += "\\u";
-          for (int i = 0; i < 4; ++i) {
-            const char ci = c[i];
-            OCCA_ERROR("Expected hex value",
-                       (('0' <= ci) && (ci <= '9')) ||
-                       (('a' <= ci) && (ci <= 'f')) ||
-                       (('A' <= ci) && (ci <= 'F')));
-            value_.string += ci;
+      while (*c != '\0') {
+        // Append characters up to the next escape or quote at once
+        const char *cStart = c;
+        while ((*c != '\0') && (*c != quote) && (*c != '\\')) {
+          ++c;
+        }
+        str.append(cStart, c - cStart);
+
+        if (*c == '\\') {
+          ++c; // Skip '\'
+          OCCA_ERROR("Unclosed string",
+                     *c != '\0');
+
+          switch (*c) {
+          case 'b':  str += '\b'; break;
+          case 'f':  str += '\f'; break;
+          case 'n':  str += '\n'; break;
+          case 'r':  str += '\r'; break;
+          case 't':  str += '\t'; break;
+          case 'u':
+            // Found unicode character
+            // Load \uXXXX
+            ++c; // Skip 'u'
+            str += "\\u";
+            for (int i = 0; i < 4; ++i) {
+              const char ci = c[i];
+              OCCA_ERROR("Expected hex value",
+                         (('0' <= ci) && (ci <= '9')) ||
+                         (('a' <= ci) && (ci <= 'f')) ||
+                         (('A' <= ci) && (ci <= 'F')));
+              str += ci;
+            }
+            // Let the ++c increment the last character
+            c += 3;
+            break;
+          default:
+            str += *c;
           }
-          // Let the ++c increment the last character
-          c += 3;
-          break;
-        default:
-          value_.string += *c;
+          // Skip the last used character
+          ++c;
+        } else if (*c == quote) {
+          ++c;
+          return;
         }
-        // Skip the last used character
-        ++c;
-      } else if (*c == quote) {
-        ++c;
-        return;
-      } else {
-        value_.string += *(c++);
       }
+      OCCA_FORCE_ERROR("Unclosed string");
     }
-    OCCA_FORCE_ERROR("Unclosed string");
+
+    // Loads plain decimal integers without going through
+    //   primitive::load, giving the same int32_t primitive
+    bool loadInteger(const char *&c, primitive &value) {
+      const char *cEnd = c + (*c == '-');
+      int64_t integer = 0;
+      int digits = 0;
+      while (('0' <= *cEnd) && (*cEnd <= '9') && (digits < 18)) {
+        integer = (10 * integer) + (*cEnd - '0');
+        ++cEnd;
+        ++digits;
+      }
+      // Leading zeros are octal for primitive::load
+      if (!digits ||
+          ((digits > 1) && (cEnd[-digits] == '0'))) {
+        return false;
+      }
+      switch (*cEnd) {
+      case '0': case '1': case '2': case '3': case '4':
+      case '5': case '6': case '7': case '8': case '9':
+      case '.': case 'e': case 'E': case 'f': case 'F':
+      case 'l': case 'L': case 'u': case 'U':
+      case 'x': case 'X': case 'b': case 'B':
+        return false;
+      default: ;
+      }
+      value = (int32_t) ((*c == '-') ? -integer : integer);
+      c = cEnd;
+      return true;
+    }
+  }
+
+  void json::loadString(const char *&c) {
+    type = string_;
+    cachedHash.clear();
+    loadQuotedString(c, value_.editString());
   }
 
   void json::loadNumber(const char *&c) {
     type = number_;
-    value_.number = primitive::load(c);
+    if (!loadInteger(c, value_.number)) {
+      value_.number = primitive::load(c);
+    }
+    cachedHash.clear();
   }
 
   void json::loadObject(const char *&c) {
@@ -158,6 +469,7 @@ namespace occa {
       ++c;
     }
     type = object_;
+    cachedHash.clear();
 
     while (*c != '\0') {
       lex::skipWhitespace(c);
@@ -194,9 +506,7 @@ namespace occa {
   void json::loadObjectField(const char *&c) {
     std::string key;
     if (*c == '"') {
-      json jKey;
-      jKey.loadString(c);
-      key = jKey.value_.string;
+      loadQuotedString(c, key);
     } else {
       const char *cStart = c;
       lex::skipTo(c, objectKeyEndChars);
@@ -209,13 +519,19 @@ namespace occa {
     OCCA_ERROR("Key must be followed by ':'",
                *c == ':');
     ++c;
-    value_.object[key].load(c);
+
+    // Written objects come with sorted keys, making end() a good hint
+    jsonObject &obj = value_.editObject();
+    jsonObjectIterator it = obj.insert(obj.end(),
+                                       jsonObject::value_type(key, json()));
+    it->second.load(c);
   }
 
   void json::loadArray(const char *&c) {
     // Skip [
     ++c;
     type = array_;
+    cachedHash.clear();
 
     while (*c != '\0') {
       lex::skipWhitespace(c);
@@ -224,8 +540,9 @@ namespace occa {
         break;
       }
 
-      value_.array.push_back(json());
-      value_.array[value_.array.size() - 1].load(c);
+      jsonArray &array = value_.editArray();
+      array.push_back(json());
+      array.back().load(c);
       lex::skipWhitespace(c);
 
       if (*c == ',') {
@@ -249,6 +566,7 @@ namespace occa {
     c += 4;
     type = boolean_;
     value_.boolean = true;
+    cachedHash.clear();
   }
 
   void json::loadFalse(const char *&c) {
@@ -257,6 +575,7 @@ namespace occa {
     c += 5;
     type = boolean_;
     value_.boolean = false;
+    cachedHash.clear();
   }
 
   void json::loadNull(const char *&c) {
@@ -264,6 +583,7 @@ namespace occa {
                !strncmp(c, "null", 4));
     c += 4;
     type = null_;
+    cachedHash.clear();
   }
 
   json json::operator + (const json &j) const {
@@ -277,12 +597,13 @@ namespace occa {
                (type == array_) ||
                (type == j.type));
 
+    cachedHash.clear();
     switch(type) {
     case none_: {
       break;
     }
     case string_: {
-      value_.string += j.value_.string;
+      value_.editString() += j.value_.string();
       break;
     }
     case number_: {
@@ -290,11 +611,11 @@ namespace occa {
       break;
     }
     case object_: {
-      mergeWithObject(j.value_.object);
+      mergeWithObject(j.value_.object());
       break;
     }
     case array_: {
-      value_.array.push_back(j);
+      value_.editArray().push_back(j);
       break;
     }
     case boolean_: {
@@ -308,6 +629,7 @@ namespace occa {
   }
 
   void json::mergeWithObject(const jsonObject &obj) {
+    cachedHash.clear();
     cJsonObjectIterator it = obj.begin();
     while (it != obj.end()) {
       const std::string &key = it->first;
@@ -317,14 +639,14 @@ namespace occa {
       // If we're merging two json objects, recursively merge them
       if (val.isObject() && has(key)) {
         // Reuse prefetch
-        json &oldVal = value_.object[key];
+        json &oldVal = value_.editObject()[key];
         if (oldVal.isObject()) {
           oldVal += val;
         } else {
           oldVal = val;
         }
       } else {
-        value_.object[key] = val;
+        value_.editObject()[key] = val;
       }
     }
   }
@@ -345,8 +667,8 @@ namespace occa {
         ++c;
       }
 
-      cJsonObjectIterator it = j->value_.object.find(key);
-      if (it == j->value_.object.end()) {
+      cJsonObjectIterator it = j->value_.object().find(key);
+      if (it == j->value_.object().end()) {
         return false;
       }
       j = &(it->second);
@@ -358,6 +680,7 @@ namespace occa {
     const char *c0 = c;
     json *j = this;
 
+    cachedHash.clear();
     if (type == none_) {
       type = object_;
     }
@@ -373,7 +696,8 @@ namespace occa {
         ++c;
       }
 
-      j = &(j->value_.object[key]);
+      j = &(j->value_.object()[key]);
+      j->cachedHash.clear();
       if (j->type == none_) {
         j->type = object_;
       }
@@ -396,8 +720,8 @@ namespace occa {
         ++c;
       }
 
-      cJsonObjectIterator it = j->value_.object.find(key);
-      if (it == j->value_.object.end()) {
+      cJsonObjectIterator it = j->value_.object().find(key);
+      if (it == j->value_.object().end()) {
         return default_;
       }
       j = &(it->second);
@@ -408,13 +732,15 @@ namespace occa {
   json& json::operator [] (const int n) {
     OCCA_ERROR("Can only apply operator [] with JSON arrays",
                type == array_);
-    return value_.array[n];
+    cachedHash.clear();
+    value_.array()[n].cachedHash.clear();
+    return value_.array()[n];
   }
 
   const json& json::operator [] (const int n) const {
     OCCA_ERROR("Can only apply operator [] with JSON arrays",
                type == array_);
-    return value_.array[n];
+    return value_.array()[n];
   }
 
   int json::size() const {
@@ -429,10 +755,10 @@ namespace occa {
       return 1;
     }
     case object_: {
-      return (int) value_.object.size();
+      return (int) value_.object().size();
     }
     case array_: {
-      return (int) value_.array.size();
+      return (int) value_.array().size();
     }
     case boolean_: {
       return 1;
@@ -449,6 +775,7 @@ namespace occa {
       if (j->type != object_) {
         return *this;
       }
+      j->cachedHash.clear();
 
       const char *cStart = c;
       lex::skipTo(c, '/', '\\');
@@ -458,12 +785,13 @@ namespace occa {
       }
 
       if (*c == '\0') {
-        j->value_.object.erase(key);
+        j->value_.editObject().erase(key);
         return *this;
       }
 
-      jsonObjectIterator it = j->value_.object.find(key);
-      if (it == j->value_.object.end()) {
+      jsonObject &obj = j->value_.editObject();
+      jsonObjectIterator it = obj.find(key);
+      if (it == obj.end()) {
         return *this;
       }
       j = &(it->second);
@@ -471,10 +799,96 @@ namespace occa {
     return *this;
   }
 
+  namespace {
+    // Numbers that compare equal hash the same, integral values are
+    //   hashed as integers regardless of their primitive type
+    void appendNumber(std::string &out, const primitive &p) {
+      char tag = 'i';
+      uint64_t bits = 0;
+      if (p.isFloat()) {
+        const double d = p.to<double>();
+        if ((-9.2e18 < d) && (d < 9.2e18) &&
+            (d == (double) (int64_t) d)) {
+          bits = (uint64_t) (int64_t) d;
+        } else {
+          tag = 'f';
+          ::memcpy(&bits, &d, sizeof(bits));
+        }
+      } else if (p.isUnsigned()) {
+        bits = p.to<uint64_t>();
+        if (bits >> 63) {
+          tag = 'u';
+        }
+      } else {
+        bits = (uint64_t) p.to<int64_t>();
+      }
+      out += tag;
+      out.append((const char*) &bits, sizeof(bits));
+    }
+
+    void appendSize(std::string &out, const size_t size) {
+      const uint64_t size64 = size;
+      out.append((const char*) &size64, sizeof(size64));
+    }
+  }
+
   hash_t json::hash() const {
+    // References into leaked containers can modify descendants without
+    //   going through this node, leaving a memo stale
+    const bool memoize = value_.isShareable();
+    hash_t cached;
+    if (memoize &&
+        cachedHash.get(cached)) {
+      return cached;
+    }
+
+    // Hash the node's own contents with the memoized hashes of its
+    //   children rather than a serialized string of the whole tree
     std::string out;
-    toString(out);
-    return occa::hash(out);
+    out += (char) type;
+    switch(type) {
+    case string_: {
+      appendSize(out, value_.string().size());
+      out += value_.string();
+      break;
+    }
+    case number_: {
+      appendNumber(out, value_.number);
+      break;
+    }
+    case object_: {
+      appendSize(out, value_.object().size());
+      cJsonObjectIterator it = value_.object().begin();
+      while (it != value_.object().end()) {
+        appendSize(out, it->first.size());
+        out += it->first;
+        const hash_t childHash = it->second.hash();
+        out.append((const char*) childHash.h, sizeof(childHash.h));
+        ++it;
+      }
+      break;
+    }
+    case array_: {
+      const int arraySize = (int) value_.array().size();
+      appendSize(out, arraySize);
+      for (int i = 0; i < arraySize; ++i) {
+        const hash_t childHash = value_.array()[i].hash();
+        out.append((const char*) childHash.h, sizeof(childHash.h));
+      }
+      break;
+    }
+    case boolean_: {
+      out += (char) value_.boolean;
+      break;
+    }
+    default: ;
+    }
+
+    const hash_t ret = occa::hash(out);
+    if (memoize) {
+      cachedHash.set(ret);
+    }
+    return ret;
   }
 
   std::string json::toString(const int indent) const {
@@ -484,18 +898,13 @@ namespace occa {
     return out;
   }
 
-  void json::toString(std::string &out,
-                      const std::string &indent,
-                      const std::string &currentIndent) const {
-    switch(type) {
-    case none_: {
-      return;
-    }
-    case string_: {
+  namespace {
+    // Keys are quoted the same way as string values to load back as-is
+    void appendQuotedString(std::string &out, const std::string &str) {
       out += '"';
-      const int chars = (int) value_.string.size();
+      const int chars = (int) str.size();
       for (int i = 0; i < chars; ++i) {
-        const char c = value_.string[i];
+        const char c = str[i];
         switch (c) {
         case '"' : out += "\\\"";  break;
         case '\\': out += "\\\\";  break;
@@ -509,6 +918,18 @@ namespace occa {
         }
       }
       out += '"';
+    }
+  }
+
+  void json::toString(std::string &out,
+                      const std::string &indent,
+                      const std::string &currentIndent) const {
+    switch(type) {
+    case none_: {
+      return;
+    }
+    case string_: {
+      appendQuotedString(out, value_.string());
       break;
     }
     case number_: {
@@ -516,23 +937,22 @@ namespace occa {
       break;
     }
     case object_: {
-      cJsonObjectIterator it = value_.object.begin();
+      cJsonObjectIterator it = value_.object().begin();
       out += '{';
-      if (it != value_.object.end()) {
+      if (it != value_.object().end()) {
         std::string newIndent = currentIndent + indent;
         if (indent.size()) {
           out += '\n';
         }
-        while (it != value_.object.end()) {
+        while (it != value_.object().end()) {
           out += newIndent;
-          out += '"';
-          out += it->first;
-          out += "\": ";
+          appendQuotedString(out, it->first);
+          out += ": ";
           it->second.toString(out, indent, newIndent);
           ++it;
           if (indent.size()) {
             out += ",\n";
-          } else if (it != value_.object.end()) {
+          } else if (it != value_.object().end()) {
             out += ", ";
           }
         }
@@ -545,7 +965,7 @@ namespace occa {
     }
     case array_: {
       out += '[';
-      const int arraySize = (int) value_.array.size();
+      const int arraySize = (int) value_.array().size();
       if (arraySize) {
         std::string newIndent = currentIndent + indent;
         if (indent.size()) {
@@ -553,7 +973,7 @@ namespace occa {
         }
         for (int i = 0; i < arraySize; ++i) {
           out += newIndent;
-          value_.array[i].toString(out, indent, newIndent);
+          value_.array()[i].toString(out, indent, newIndent);
           if (indent.size()) {
             out += ",\n";
           } else if (i < (arraySize - 1)) {
@@ -577,7 +997,7 @@ namespace occa {
   strVector json::keys() const {
     strVector vec;
     if (type == object_) {
-      const jsonObject &obj = value_.object;
+      const jsonObject &obj = value_.object();
       cJsonObjectIterator it = obj.begin();
       while (it != obj.end()) {
         vec.push_back(it->first);
@@ -588,22 +1008,14 @@ namespace occa {
   }
 
   jsonArray json::values() {
-    jsonArray vec;
-    if (type == object_) {
-      jsonObject &obj = value_.object;
-      jsonObjectIterator it = obj.begin();
-      while (it != obj.end()) {
-        vec.push_back(it->second);
-        ++it;
-      }
-    }
-    return vec;
+    const json &j = *this;
+    return j.values();
   }
 
   jsonArray json::values() const {
     jsonArray vec;
     if (type == object_) {
-      const jsonObject &obj = value_.object;
+      const jsonObject &obj = value_.object();
       cJsonObjectIterator it = obj.begin();
       while (it != obj.end()) {
         vec.push_back(it->second);
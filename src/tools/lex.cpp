@@ -214,7 +214,16 @@ namespace occa {
     }
 
     void skipWhitespace(const char *&c) {
-      skipFrom(c, whitespaceChars);
+      while (true) {
+        switch (*c) {
+        case ' ': case '\t': case '\r':
+        case '\n': case '\v': case '\f':
+          ++c;
+          continue;
+        default:
+          return;
+        }
+      }
     }
 
     void skipWhitespace(const char *&c, const char escapeChar) {
@@ -0,0 +1,340 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2014-2018 David Medina and Tim Warburton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ */
+
+#include "occa/defines.hpp"
+
+#if (OCCA_OS & OCCA_LINUX_OS)
+#  include <linux/perf_event.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#endif
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <set>
+
+#include "occa/tools/io.hpp"
+#include "occa/tools/perfCounters.hpp"
+#include "occa/tools/string.hpp"
+
+namespace occa {
+  //---[ perfCounterValues ]------------
+  perfCounterValues::perfCounterValues() :
+    available(0),
+    cycles(0),
+    instructions(0),
+    llcMisses(0),
+    memoryBytes(0) {}
+
+  perfCounterValues perfCounterValues::operator - (const perfCounterValues &values) const {
+    perfCounterValues diff;
+    diff.available    = (available & values.available);
+    diff.cycles       = cycles       - values.cycles;
+    diff.instructions = instructions - values.instructions;
+    diff.llcMisses    = llcMisses    - values.llcMisses;
+    diff.memoryBytes  = memoryBytes  - values.memoryBytes;
+    return diff;
+  }
+
+  perfCounterValues& perfCounterValues::operator += (const perfCounterValues &values) {
+    available    |= values.available;
+    cycles       += values.cycles;
+    instructions += values.instructions;
+    llcMisses    += values.llcMisses;
+    memoryBytes  += values.memoryBytes;
+    return *this;
+  }
+
+  bool perfCounterValues::has(const int counters) const {
+    return ((available & counters) == counters);
+  }
+  //====================================
+
+  //---[ perfCounters ]-----------------
+  perfCounters::perfCounters() :
+    isSetup(false) {}
+
+  perfCounters::~perfCounters() {
+    free();
+  }
+
+#if (OCCA_OS & OCCA_LINUX_OS)
+  namespace {
+    int perfEventOpen(perf_event_attr &attr,
+                      const int pid,
+                      const int cpu,
+                      const int groupFd) {
+      return (int) ::syscall(__NR_perf_event_open,
+                             &attr, pid, cpu, groupFd, 0);
+    }
+
+    std::string readSysFile(const std::string &filename) {
+      std::ifstream file(filename.c_str());
+      std::string contents;
+      std::getline(file, contents);
+      return contents;
+    }
+
+    void addThreadValues(perfCounterValues &values,
+                         const std::vector<int> &counters,
+                         const uint64_t *counts) {
+      const int counterCount = (int) counters.size();
+      for (int i = 0; i < counterCount; ++i) {
+        const int counter = counters[i];
+        values.available |= counter;
+        switch (counter) {
+        case perfCounter::cycles:
+          values.cycles += counts[i]; break;
+        case perfCounter::instructions:
+          values.instructions += counts[i]; break;
+        case perfCounter::llcMisses:
+          values.llcMisses += counts[i]; break;
+        }
+      }
+    }
+  }
+
+  bool perfCounters::setup() {
+    if (isSetup) {
+      return (threads.size() || memoryCounters.size());
+    }
+    isSetup = true;
+
+    addNewThreads();
+    addMemoryCounters();
+
+    bool hasCounters = memoryCounters.size();
+    std::map<int, threadCounters>::iterator it = threads.begin();
+    while (it != threads.end()) {
+      hasCounters |= (bool) it->second.fds.size();
+      ++it;
+    }
+    if (!hasCounters) {
+      free();
+    }
+    return hasCounters;
+  }
+
+  void perfCounters::free() {
+    std::map<int, threadCounters>::iterator it = threads.begin();
+    while (it != threads.end()) {
+      const std::vector<int> &fds = it->second.fds;
+      for (int i = 0; i < (int) fds.size(); ++i) {
+        ::close(fds[i]);
+      }
+      ++it;
+    }
+    threads.clear();
+
+    for (int i = 0; i < (int) memoryCounters.size(); ++i) {
+      ::close(memoryCounters[i].fd);
+    }
+    memoryCounters.clear();
+
+    exitedThreadValues = perfCounterValues();
+  }
+
+  perfCounterValues perfCounters::read() {
+    perfCounterValues values = exitedThreadValues;
+    if (!isSetup) {
+      return values;
+    }
+
+    addNewThreads();
+
+    uint64_t buffer[1 + 3];
+    std::map<int, threadCounters>::iterator it = threads.begin();
+    while (it != threads.end()) {
+      threadCounters &tc = it->second;
+      ++it;
+      if (!tc.fds.size()) {
+        continue;
+      }
+      // PERF_FORMAT_GROUP reads: { count, values[count] }
+      if (::read(tc.fds[0], buffer, sizeof(buffer)) > 0) {
+        addThreadValues(values, tc.counters, buffer + 1);
+      }
+    }
+
+    for (int i = 0; i < (int) memoryCounters.size(); ++i) {
+      const memoryCounter &mc = memoryCounters[i];
+      uint64_t count;
+      if (::read(mc.fd, &count, sizeof(count)) > 0) {
+        values.available   |= perfCounter::memoryBytes;
+        values.memoryBytes += count * mc.bytesPerCount;
+      }
+    }
+    return values;
+  }
+
+  void perfCounters::addNewThreads() {
+    strVector taskDirs = io::directories("/proc/self/task");
+    std::set<int> tids;
+    for (int i = 0; i < (int) taskDirs.size(); ++i) {
+      const std::string &dir = taskDirs[i];
+      // Directories end with '/'
+      const size_t nameStart = dir.rfind('/', dir.size() - 2) + 1;
+      tids.insert(std::atoi(dir.c_str() + nameStart));
+    }
+
+    // Exited threads keep their final counts
+    uint64_t buffer[1 + 3];
+    std::map<int, threadCounters>::iterator it = threads.begin();
+    while (it != threads.end()) {
+      if (tids.count(it->first)) {
+        ++it;
+        continue;
+      }
+      threadCounters &tc = it->second;
+      if (tc.fds.size() &&
+          (::read(tc.fds[0], buffer, sizeof(buffer)) > 0)) {
+        addThreadValues(exitedThreadValues, tc.counters, buffer + 1);
+      }
+      for (int i = 0; i < (int) tc.fds.size(); ++i) {
+        ::close(tc.fds[i]);
+      }
+      threads.erase(it++);
+    }
+
+    std::set<int>::iterator tidIt = tids.begin();
+    while (tidIt != tids.end()) {
+      if (!threads.count(*tidIt)) {
+        addThread(*tidIt);
+      }
+      ++tidIt;
+    }
+  }
+
+  void perfCounters::addThread(const int tid) {
+    static const int counters[3] = {
+      perfCounter::cycles,
+      perfCounter::instructions,
+      perfCounter::llcMisses
+    };
+    static const uint64_t configs[3] = {
+      PERF_COUNT_HW_CPU_CYCLES,
+      PERF_COUNT_HW_INSTRUCTIONS,
+      PERF_COUNT_HW_CACHE_MISSES
+    };
+
+    // Threads without counters are stored to avoid retrying them
+    threadCounters &tc = threads[tid];
+    for (int i = 0; i < 3; ++i) {
+      perf_event_attr attr;
+      ::memset(&attr, 0, sizeof(attr));
+      attr.size           = sizeof(attr);
+      attr.type           = PERF_TYPE_HARDWARE;
+      attr.config         = configs[i];
+      attr.read_format    = PERF_FORMAT_GROUP;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv     = 1;
+
+      const int fd = perfEventOpen(attr,
+                                   tid, -1,
+                                   tc.fds.size() ? tc.fds[0] : -1);
+      if (fd >= 0) {
+        tc.fds.push_back(fd);
+        tc.counters.push_back(counters[i]);
+      }
+    }
+  }
+
+  void perfCounters::addMemoryCounters() {
+    static const char *events[2] = {
+      "cas_count_read",
+      "cas_count_write"
+    };
+    // Each CAS command moves a 64-byte cache line
+    static const udim_t bytesPerCas = 64;
+
+    strVector pmus = io::directories("/sys/bus/event_source/devices");
+    for (int i = 0; i < (int) pmus.size(); ++i) {
+      const std::string &pmu = pmus[i];
+      if (pmu.find("/uncore_imc") == std::string::npos) {
+        continue;
+      }
+      const int type = std::atoi(readSysFile(pmu + "type").c_str());
+      // Uncore events are counted on one CPU per socket
+      const strVector cpus = split(readSysFile(pmu + "cpumask"), ',');
+
+      for (int e = 0; e < 2; ++e) {
+        // Events look like "event=0x04,umask=0x03" with fields placed
+        //   by format files like "config:8-15"
+        const std::string event = readSysFile(pmu + "events/" + events[e]);
+        if (!event.size()) {
+          continue;
+        }
+        uint64_t config = 0;
+        strVector terms = split(event, ',');
+        for (int t = 0; t < (int) terms.size(); ++t) {
+          const size_t equals = terms[t].find('=');
+          const std::string format = readSysFile(pmu + "format/" + terms[t].substr(0, equals));
+          const size_t colon = format.find(':');
+          if ((equals == std::string::npos) ||
+              (colon == std::string::npos) ||
+              (format.compare(0, colon, "config") != 0)) {
+            config = 0;
+            break;
+          }
+          const int lowBit = std::atoi(format.c_str() + colon + 1);
+          config |= (std::strtoull(terms[t].c_str() + equals + 1, NULL, 0) << lowBit);
+        }
+        if (!config) {
+          continue;
+        }
+
+        perf_event_attr attr;
+        ::memset(&attr, 0, sizeof(attr));
+        attr.size   = sizeof(attr);
+        attr.type   = type;
+        attr.config = config;
+
+        for (int c = 0; c < (int) cpus.size(); ++c) {
+          memoryCounter mc;
+          mc.fd = perfEventOpen(attr, -1, std::atoi(cpus[c].c_str()), -1);
+          mc.bytesPerCount = bytesPerCas;
+          if (mc.fd >= 0) {
+            memoryCounters.push_back(mc);
+          }
+        }
+      }
+    }
+  }
+#else
+  bool perfCounters::setup() {
+    isSetup = true;
+    return false;
+  }
+
+  void perfCounters::free() {}
+
+  perfCounterValues perfCounters::read() {
+    return perfCounterValues();
+  }
+
+  void perfCounters::addNewThreads() {}
+  void perfCounters::addThread(const int tid) {}
+  void perfCounters::addMemoryCounters() {}
+#endif
+  //====================================
+}
@@ -25,6 +25,31 @@
 #include "occa/parser/parser.hpp"
 
 namespace occa {
+  //---[ path ]-------------------------
+  properties::path::path(const char *c) :
+    str(c) {
+    split();
+  }
+
+  properties::path::path(const std::string &s) :
+    str(s) {
+    split();
+  }
+
+  // Splits keys the same way as json::has and json::operator []
+  void properties::path::split() {
+    const char *c = str.c_str();
+    while (*c != '\0') {
+      const char *cStart = c;
+      lex::skipTo(c, '/', '\\');
+      keys.push_back(std::string(cStart, c - cStart));
+      if (*c == '/') {
+        ++c;
+      }
+    }
+  }
+  //====================================
+
   properties::properties() {
     type = object_;
   }
@@ -43,7 +68,8 @@ namespace occa {
   }
 
   bool properties::isInitialized() {
-    return (0 < value_.object.size());
+    const jsonValue_t &value = value_;
+    return (0 < value.object().size());
   }
 
   void properties::load(const char *&c) {
@@ -55,6 +81,55 @@ namespace occa {
     loadObject(c);
   }
 
+  const json* properties::find(const path &p) const {
+    const json *j = this;
+    const int keyCount = (int) p.keys.size();
+    for (int i = 0; i < keyCount; ++i) {
+      if (j->type != object_) {
+        return NULL;
+      }
+      const jsonObject &obj = j->value_.object();
+      cJsonObjectIterator it = obj.find(p.keys[i]);
+      if (it == obj.end()) {
+        return NULL;
+      }
+      j = &(it->second);
+    }
+    return j;
+  }
+
+  bool properties::has(const path &p) const {
+    return find(p) != NULL;
+  }
+
+  json& properties::operator [] (const path &p) {
+    json *j = this;
+
+    cachedHash.clear();
+    if (type == none_) {
+      type = object_;
+    }
+
+    const int keyCount = (int) p.keys.size();
+    for (int i = 0; i < keyCount; ++i) {
+      OCCA_ERROR("Path '" << p.str << "' is not an object",
+                 j->type == object_);
+
+      j = &(j->value_.object()[p.keys[i]]);
+      j->cachedHash.clear();
+      if (j->type == none_) {
+        j->type = object_;
+      }
+    }
+    return *j;
+  }
+
+  const json& properties::operator [] (const path &p) const {
+    static json default_;
+    const json *j = find(p);
+    return j ? *j : default_;
+  }
+
   template <>
   hash_t hash(const properties &props) {
     return props.hash();
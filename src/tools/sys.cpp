@@ -26,15 +26,17 @@
 #  include <ctime>
 #  include <cxxabi.h>
 #  include <dlfcn.h>
+#  include <errno.h>
 #  include <execinfo.h>
+#  include <fcntl.h>
 #  include <pthread.h>
 #  include <signal.h>
+#  include <sys/mman.h>
 #  include <sys/syscall.h>
 #  include <sys/sysctl.h>
 #  include <sys/time.h>
 #  include <unistd.h>
 #  if (OCCA_OS & OCCA_LINUX_OS)
-#    include <errno.h>
 #    include <sys/sysinfo.h>
 #  else // OCCA_MACOS_OS
 #    include <mach/mach_host.h>
@@ -53,9 +55,14 @@
 #  include <windows.h>
 #endif
 
+#include <cstring>
 #include <iomanip>
 #include <sstream>
 
+#if OCCA_SSE2
+#  include <emmintrin.h>
+#endif
+
 #include <sys/types.h>
 #include <fcntl.h>
 
@@ -118,6 +125,21 @@ namespace occa {
 #endif
     }
 
+    void sleep(const double seconds) {
+      if (seconds <= 0) {
+        return;
+      }
+#if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
+      timespec duration;
+      duration.tv_sec  = (time_t) seconds;
+      duration.tv_nsec = (long) (1.0e9 * (seconds - duration.tv_sec));
+      while ((::nanosleep(&duration, &duration) == -1) &&
+             (errno == EINTR)) {}
+#else
+      ::Sleep((DWORD) (1000 * seconds));
+#endif
+    }
+
     std::string date() {
       ::time_t time_ = ::time(0);
       struct ::tm &timeInfo = *(::localtime(&time_));
@@ -630,8 +652,8 @@ namespace occa {
 
       const std::string compilerVendorTest = env::OCCA_DIR + "/scripts/compilerVendorTest.cpp";
       hash_t hash = occa::hashFile(compilerVendorTest);
-      hash ^= occa::hash(vendor_);
-      hash ^= occa::hash(compiler);
+      hash.update(&vendor_, sizeof(vendor_));
+      hash.update(compiler);
 
       const std::string srcFilename = io::cacheFile(compilerVendorTest, "compilerVendorTest.cpp", hash);
       const std::string hashDir = io::dirname(srcFilename);
@@ -744,6 +766,235 @@ namespace occa {
       ::free(ptr);
     }
 
+    void nonTemporalMemcpy(void *dest,
+                           const void *src,
+                           const udim_t bytes) {
+#if OCCA_SSE2
+      char *dest_       = (char*) dest;
+      const char *src_  = (const char*) src;
+
+      // Streaming stores need a 16-byte aligned destination
+      const udim_t head = ((16 - (((udim_t) dest_) & 15)) & 15);
+      if (bytes < (head + 64)) {
+        ::memcpy(dest, src, bytes);
+        return;
+      }
+      ::memcpy(dest_, src_, head);
+
+      udim_t i = head;
+      for (; (i + 64) <= bytes; i += 64) {
+        const __m128i v0 = _mm_loadu_si128((const __m128i*) (src_ + i));
+        const __m128i v1 = _mm_loadu_si128((const __m128i*) (src_ + i + 16));
+        const __m128i v2 = _mm_loadu_si128((const __m128i*) (src_ + i + 32));
+        const __m128i v3 = _mm_loadu_si128((const __m128i*) (src_ + i + 48));
+        _mm_stream_si128((__m128i*) (dest_ + i)     , v0);
+        _mm_stream_si128((__m128i*) (dest_ + i + 16), v1);
+        _mm_stream_si128((__m128i*) (dest_ + i + 32), v2);
+        _mm_stream_si128((__m128i*) (dest_ + i + 48), v3);
+      }
+      ::memcpy(dest_ + i, src_ + i, bytes - i);
+
+      // Order the streaming stores before anything that follows
+      _mm_sfence();
+#else
+      ::memcpy(dest, src, bytes);
+#endif
+    }
+
+    void* mallocPages(const udim_t bytes,
+                      const bool hugepages,
+                      const bool transparentHugepages,
+                      udim_t &mappedBytes) {
+#if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
+      void *ptr = MAP_FAILED;
+      bool useTransparentHugepages = transparentHugepages;
+
+#  if (OCCA_OS & OCCA_LINUX_OS)
+      if (hugepages) {
+        // Assumes the default 2MB huge pages
+        const udim_t hugePageBytes = (1 << 21);
+        mappedBytes = (((bytes + hugePageBytes - 1) / hugePageBytes) * hugePageBytes);
+
+        ptr = ::mmap(NULL, mappedBytes,
+                     PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANON | MAP_HUGETLB,
+                     -1, 0);
+
+        if (ptr == MAP_FAILED) {
+          OCCA_FORCE_WARNING("Unable to allocate huge pages"
+                             " (none reserved?), using transparent huge pages");
+          useTransparentHugepages = true;
+        }
+      }
+#  endif
+
+      if (ptr == MAP_FAILED) {
+        const udim_t pageBytes = ::sysconf(_SC_PAGESIZE);
+        mappedBytes = (((bytes + pageBytes - 1) / pageBytes) * pageBytes);
+
+        ptr = ::mmap(NULL, mappedBytes,
+                     PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANON,
+                     -1, 0);
+      }
+
+      OCCA_ERROR("Unable to map " << bytes << " bytes",
+                 ptr != MAP_FAILED);
+
+#  if (OCCA_OS & OCCA_LINUX_OS) && defined(MADV_HUGEPAGE)
+      if (useTransparentHugepages) {
+        ::madvise(ptr, mappedBytes, MADV_HUGEPAGE);
+      }
+#  endif
+
+      return ptr;
+#else
+      mappedBytes = bytes;
+      return sys::malloc(bytes);
+#endif
+    }
+
+    void freePages(void *ptr, const udim_t mappedBytes) {
+#if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
+      ::munmap(ptr, mappedBytes);
+#else
+      sys::free(ptr);
+#endif
+    }
+
+    void* mmapFile(const std::string &filename,
+                   const udim_t offset,
+                   const udim_t bytes,
+                   const std::string &mapping,
+                   udim_t &mappedOffset,
+                   udim_t &mappedBytes) {
+      OCCA_ERROR("Unknown mapping [" << mapping << "],"
+                 " expected: readonly, private, shared",
+                 (mapping == "readonly") ||
+                 (mapping == "private")  ||
+                 (mapping == "shared"));
+
+#if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
+      const bool isShared = (mapping == "shared");
+
+      const int fd = ::open(filename.c_str(), isShared ? O_RDWR : O_RDONLY);
+      OCCA_ERROR("Failed to open [" << io::shortname(filename) << "]",
+                 fd >= 0);
+
+      // mmap offsets must be page-aligned
+      const udim_t pageBytes = ::sysconf(_SC_PAGESIZE);
+      mappedOffset = (offset % pageBytes);
+      mappedBytes  = (mappedOffset + bytes);
+
+      void *ptr = ::mmap(NULL, mappedBytes,
+                         (mapping == "readonly") ? PROT_READ : (PROT_READ | PROT_WRITE),
+                         isShared ? MAP_SHARED : MAP_PRIVATE,
+                         fd, offset - mappedOffset);
+      ::close(fd);
+
+      OCCA_ERROR("Unable to map [" << io::shortname(filename) << "]",
+                 ptr != MAP_FAILED);
+
+      return ((char*) ptr) + mappedOffset;
+#else
+      OCCA_ERROR("Shared file mappings are not supported on this OS",
+                 mapping != "shared");
+
+      mappedOffset = 0;
+      mappedBytes  = 0;
+
+      FILE *fp = fopen(filename.c_str(), "rb");
+      OCCA_ERROR("Failed to open [" << io::shortname(filename) << "]",
+                 fp != NULL);
+
+      char *ptr = (char*) sys::malloc(bytes);
+      fseek(fp, offset, SEEK_SET);
+      const size_t nread = fread(ptr, sizeof(char), bytes, fp);
+      fclose(fp);
+
+      OCCA_ERROR("Failed to read [" << io::shortname(filename) << "]",
+                 nread == bytes);
+      return ptr;
+#endif
+    }
+
+    void setNumaPolicy(void *ptr,
+                       const udim_t bytes,
+                       const std::string &policy) {
+#if (OCCA_OS & OCCA_LINUX_OS) && defined(SYS_mbind)
+      // From <numaif.h>, avoiding a libnuma dependency
+      const int MPOL_BIND_       = 2;
+      const int MPOL_INTERLEAVE_ = 3;
+      const int MPOL_LOCAL_      = 4;
+
+      const int maskBits = 1024;
+      const int longBits = 8 * sizeof(unsigned long);
+      unsigned long nodeMask[maskBits / (8 * sizeof(unsigned long))] = {0};
+
+      int mode;
+
+      if (policy == "local") {
+        mode = MPOL_LOCAL_;
+      }
+      else if (policy == "interleave") {
+        mode = MPOL_INTERLEAVE_;
+
+        // Format: 0-3,5
+        std::string online = "0";
+        if (fileExists("/sys/devices/system/node/online")) {
+          online = io::read("/sys/devices/system/node/online");
+        }
+
+        const char *c = online.c_str();
+        while (*c != '\0') {
+          const int first = ::atoi(c);
+          int last = first;
+
+          while (('0' <= *c) && (*c <= '9')) {
+            ++c;
+          }
+          if (*c == '-') {
+            last = ::atoi(++c);
+            while (('0' <= *c) && (*c <= '9')) {
+              ++c;
+            }
+          }
+          for (int n = first; (n <= last) && (n < maskBits); ++n) {
+            nodeMask[n / longBits] |= (1UL << (n % longBits));
+          }
+          while ((*c != '\0') && ((*c < '0') || ('9' < *c))) {
+            ++c;
+          }
+        }
+      }
+      else if (startsWith(policy, "node:")) {
+        mode = MPOL_BIND_;
+
+        const int node = ::atoi(policy.c_str() + 5);
+        OCCA_ERROR("NUMA node [" << node << "] is out of range",
+                   (0 <= node) && (node < maskBits));
+
+        nodeMask[node / longBits] |= (1UL << (node % longBits));
+      }
+      else {
+        OCCA_FORCE_ERROR("Unknown NUMA policy [" << policy << "],"
+                         " expected: local, interleave, node:<n>");
+        return;
+      }
+
+      const long ret = ::syscall(SYS_mbind,
+                                 ptr, bytes, mode,
+                                 (mode == MPOL_LOCAL_) ? (unsigned long*) NULL : nodeMask,
+                                 (mode == MPOL_LOCAL_) ? 0 : (maskBits + 1),
+                                 0);
+
+      OCCA_WARNING("Unable to set NUMA policy [" << policy << "]",
+                   ret == 0);
+#else
+      OCCA_FORCE_WARNING("NUMA policies are only supported on Linux");
+#endif
+    }
+
     void* dlopen(const std::string &filename,
                  const hash_t &hash,
                  const std::string &hashTag) {
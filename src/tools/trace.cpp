@@ -0,0 +1,271 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2014-2018 David Medina and Tim Warburton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ */
+
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <vector>
+
+#include "occa/tools/env.hpp"
+#include "occa/tools/io.hpp"
+#include "occa/tools/json.hpp"
+#include "occa/tools/sys.hpp"
+#include "occa/tools/trace.hpp"
+
+#if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
+#  include <pthread.h>
+#  include <unistd.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#  define OCCA_TRACE_ATOMIC_LOAD(value)         __atomic_load_n(&(value), __ATOMIC_SEQ_CST)
+#  define OCCA_TRACE_ATOMIC_STORE(value, value_) __atomic_store_n(&(value), value_, __ATOMIC_SEQ_CST)
+#else
+#  define OCCA_TRACE_ATOMIC_LOAD(value)         (value)
+#  define OCCA_TRACE_ATOMIC_STORE(value, value_) ((value) = (value_))
+#endif
+
+namespace occa {
+  namespace trace {
+    typedef std::vector<event> eventVector;
+
+    class threadBuffer {
+    public:
+      int tid;
+      // Set while the owning thread appends to [events]
+      bool isRecording;
+      eventVector events;
+
+      threadBuffer() :
+        tid(0),
+        isRecording(false) {}
+    };
+
+    static std::string& traceFilename() {
+      static std::string filename;
+      return filename;
+    }
+
+    static double& startTime() {
+      static double startTime_ = 0;
+      return startTime_;
+    }
+
+    // Thread buffers outlive their threads until flush(), which can run
+    //   after this file's statics are destroyed
+    static std::vector<threadBuffer*>& buffers() {
+      static std::vector<threadBuffer*> *buffers_ = new std::vector<threadBuffer*>();
+      return *buffers_;
+    }
+
+    static mutex& buffersMutex() {
+      static mutex *mutex_ = new mutex();
+      return *mutex_;
+    }
+
+    static bool initialize() {
+      traceFilename() = env::var("OCCA_TRACE");
+      if (traceFilename().size() == 0) {
+        return false;
+      }
+      startTime() = sys::currentTime();
+      std::atexit(flush);
+      return true;
+    }
+
+    bool enabled = initialize();
+
+    static std::string quote(const std::string &str) {
+      std::string out;
+      json(str).toString(out, "", "");
+      return out;
+    }
+
+#if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
+    static pthread_key_t key;
+    static pthread_once_t keyOnce = PTHREAD_ONCE_INIT;
+
+    static void createBufferKey() {
+      pthread_key_create(&key, NULL);
+    }
+
+    static pthread_key_t& bufferKey() {
+      pthread_once(&keyOnce, createBufferKey);
+      return key;
+    }
+#endif
+
+    static threadBuffer& getThreadBuffer() {
+#if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
+      pthread_key_t &key = bufferKey();
+      threadBuffer *buffer = (threadBuffer*) pthread_getspecific(key);
+      if (buffer == NULL) {
+        buffer = new threadBuffer();
+
+        buffersMutex().lock();
+        buffer->tid = (int) buffers().size();
+        buffers().push_back(buffer);
+        buffersMutex().unlock();
+
+        pthread_setspecific(key, buffer);
+      }
+      return *buffer;
+#else
+      // Callers hold [buffersMutex] without pthreads
+      if (buffers().size() == 0) {
+        threadBuffer *buffer = new threadBuffer();
+        buffer->tid = 0;
+        buffers().push_back(buffer);
+      }
+      return *(buffers()[0]);
+#endif
+    }
+
+    void record(const event &e) {
+#if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
+      // flush() disables recording and then waits on [isRecording],
+      //   so events are either appended before it reads or dropped
+      threadBuffer &buffer = getThreadBuffer();
+      OCCA_TRACE_ATOMIC_STORE(buffer.isRecording, true);
+      if (OCCA_TRACE_ATOMIC_LOAD(enabled)) {
+        buffer.events.push_back(e);
+      }
+      OCCA_TRACE_ATOMIC_STORE(buffer.isRecording, false);
+#else
+      buffersMutex().lock();
+      if (enabled) {
+        getThreadBuffer().events.push_back(e);
+      }
+      buffersMutex().unlock();
+#endif
+    }
+
+    //---[ scope ]----------------------
+    scope::scope(const char *category,
+                 const char *name) :
+      isActive(OCCA_TRACE_ATOMIC_LOAD(enabled)) {
+      if (isActive) {
+        e.name = name;
+        start(category);
+      }
+    }
+
+    scope::scope(const char *category,
+                 const std::string &name) :
+      isActive(OCCA_TRACE_ATOMIC_LOAD(enabled)) {
+      if (isActive) {
+        e.name = name;
+        start(category);
+      }
+    }
+
+    scope::~scope() {
+      if (isActive) {
+        e.duration = sys::currentTime() - e.start;
+        record(e);
+      }
+    }
+
+    void scope::start(const char *category) {
+      e.category = category;
+      e.start    = sys::currentTime();
+    }
+
+    void scope::addArg(const char *key, const udim_t value) {
+      if (isActive) {
+        if (e.args.size()) {
+          e.args += ", ";
+        }
+        e.args += quote(key);
+        e.args += ": ";
+        e.args += occa::toString(value);
+      }
+    }
+
+    void scope::addArg(const char *key, const std::string &value) {
+      if (isActive) {
+        if (e.args.size()) {
+          e.args += ", ";
+        }
+        e.args += quote(key);
+        e.args += ": ";
+        e.args += quote(value);
+      }
+    }
+    //==================================
+
+    void flush() {
+      // Only flush once, recording stops before the buffers are read
+      buffersMutex().lock();
+      if (!OCCA_TRACE_ATOMIC_LOAD(enabled)) {
+        buffersMutex().unlock();
+        return;
+      }
+      OCCA_TRACE_ATOMIC_STORE(enabled, false);
+
+      std::ofstream out(traceFilename().c_str());
+      if (!out) {
+        std::cerr << "Unable to write trace to [" << traceFilename() << "]\n";
+        buffersMutex().unlock();
+        return;
+      }
+
+#if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
+      const int pid = (int) ::getpid();
+#else
+      const int pid = 0;
+#endif
+
+      out << "{\"traceEvents\": [";
+
+      bool isFirst = true;
+      const int bufferCount = (int) buffers().size();
+      for (int b = 0; b < bufferCount; ++b) {
+        const threadBuffer &buffer = *(buffers()[b]);
+        // Wait for appends that started before recording stopped
+        while (OCCA_TRACE_ATOMIC_LOAD(buffer.isRecording)) {}
+
+        const int eventCount = (int) buffer.events.size();
+        for (int i = 0; i < eventCount; ++i) {
+          const event &e = buffer.events[i];
+          out << (isFirst ? "\n" : ",\n")
+              << "{\"name\": "  << quote(e.name)
+              << ", \"cat\": "  << quote(e.category)
+              << ", \"ph\": \"X\""
+              << std::fixed << std::setprecision(3)
+              << ", \"ts\": "   << (1.0e6 * (e.start - startTime()))
+              << ", \"dur\": "  << (1.0e6 * e.duration)
+              << ", \"pid\": "  << pid
+              << ", \"tid\": "  << buffer.tid;
+          if (e.args.size()) {
+            out << ", \"args\": {" << e.args << '}';
+          }
+          out << '}';
+          isFirst = false;
+        }
+      }
+      out << "\n]}\n";
+
+      buffersMutex().unlock();
+    }
+  }
+}
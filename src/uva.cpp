@@ -20,6 +20,7 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
  */
 
+#include <algorithm>
 #include <map>
 
 #include "occa/tools/misc.hpp"
@@ -62,15 +63,201 @@ namespace occa {
     return ((a != b) && (a.start < b.start));
   }
 
+  //---[ ptrRangeMap ]------------------
+#if defined(__GNUC__) || defined(__clang__)
+#  define OCCA_UVA_ATOMIC_LOAD(value)         __atomic_load_n(&(value), __ATOMIC_SEQ_CST)
+#  define OCCA_UVA_ATOMIC_STORE(value, value_) __atomic_store_n(&(value), value_, __ATOMIC_SEQ_CST)
+#  define OCCA_UVA_ATOMIC_ADD(value, value_)   __atomic_fetch_add(&(value), value_, __ATOMIC_SEQ_CST)
+#  define OCCA_UVA_LOCK_READS 0
+#else
+#  define OCCA_UVA_ATOMIC_LOAD(value)         (value)
+#  define OCCA_UVA_ATOMIC_STORE(value, value_) ((value) = (value_))
+#  define OCCA_UVA_ATOMIC_ADD(value, value_)   ((value) += (value_))
+#  define OCCA_UVA_LOCK_READS 1
+#endif
+
+  ptrRangeMap::entry::entry() :
+    start(NULL),
+    end(NULL),
+    mem(NULL) {}
+
+  ptrRangeMap::entry::entry(const ptrRange &range,
+                            occa::memory_v *mem_) :
+    start(range.start),
+    end(range.end),
+    mem(mem_) {}
+
+  static bool entryStartsBefore(const char *ptr,
+                                const ptrRangeMap::entry &e) {
+    return (ptr < e.start);
+  }
+
+  // Index of the entry containing [ptr] or -1
+  static dim_t findEntry(const ptrRangeMap::entryVector &entries,
+                         const char *ptr) {
+    ptrRangeMap::entryVector::const_iterator it = std::upper_bound(entries.begin(),
+                                                                   entries.end(),
+                                                                   ptr,
+                                                                   entryStartsBefore);
+    if (it == entries.begin()) {
+      return -1;
+    }
+    --it;
+    return (it->contains(ptr)
+            ? (dim_t) (it - entries.begin())
+            : -1);
+  }
+
+  ptrRangeMap::ptrRangeMap() :
+    entries(new entryVector()),
+    isDirty(0),
+    activeReaders(0) {}
+
+  ptrRangeMap::~ptrRangeMap() {
+    freeRetiredEntries();
+    delete entries;
+    writeMutex.free();
+  }
+
+  void ptrRangeMap::insert(const ptrRange &range,
+                           occa::memory_v *mem) {
+    writeMutex.lock();
+    pendingInserts[range.start] = entry(range, mem);
+    OCCA_UVA_ATOMIC_STORE(isDirty, 1);
+    writeMutex.unlock();
+  }
+
+  void ptrRangeMap::erase(const void *ptr) {
+    char *ptr_ = (char*) ptr;
+
+    writeMutex.lock();
+    // Pending inserts are newer than the published entries
+    std::map<char*, entry>::iterator it = pendingInserts.upper_bound(ptr_);
+    if (it != pendingInserts.begin()) {
+      --it;
+      if (it->second.contains(ptr_)) {
+        pendingInserts.erase(it);
+        writeMutex.unlock();
+        return;
+      }
+    }
+    const dim_t index = findEntry(*entries, ptr_);
+    if (index >= 0) {
+      pendingErases.insert((*entries)[index].start);
+      OCCA_UVA_ATOMIC_STORE(isDirty, 1);
+    }
+    writeMutex.unlock();
+  }
+
+  // Called with [writeMutex] locked
+  void ptrRangeMap::publish() {
+    if (!isDirty) {
+      return;
+    }
+
+    const entryVector &oldEntries = *entries;
+    const dim_t oldCount = (dim_t) oldEntries.size();
+
+    // Merge the remaining entries with the sorted pending inserts
+    entryVector *newEntries = new entryVector();
+    newEntries->reserve(oldCount + pendingInserts.size());
+
+    std::map<char*, entry>::iterator it = pendingInserts.begin();
+    for (dim_t i = 0; i < oldCount; ++i) {
+      if (pendingErases.count(oldEntries[i].start)) {
+        continue;
+      }
+      while ((it != pendingInserts.end()) &&
+             (it->first < oldEntries[i].start)) {
+        newEntries->push_back(it->second);
+        ++it;
+      }
+      newEntries->push_back(oldEntries[i]);
+    }
+    for (; it != pendingInserts.end(); ++it) {
+      newEntries->push_back(it->second);
+    }
+
+    pendingInserts.clear();
+    pendingErases.clear();
+
+    retiredEntries.push_back(entries);
+    OCCA_UVA_ATOMIC_STORE(entries, newEntries);
+    OCCA_UVA_ATOMIC_STORE(isDirty, 0);
+
+    if (OCCA_UVA_ATOMIC_LOAD(activeReaders) == 0) {
+      freeRetiredEntries();
+    }
+  }
+
+  void ptrRangeMap::freeRetiredEntries() {
+    const int retiredCount = (int) retiredEntries.size();
+    for (int i = 0; i < retiredCount; ++i) {
+      delete retiredEntries[i];
+    }
+    retiredEntries.clear();
+  }
+
+  // Called with [writeMutex] locked
+  occa::memory_v* ptrRangeMap::findPending(const char *ptr) {
+    std::map<char*, entry>::iterator it = pendingInserts.upper_bound((char*) ptr);
+    if (it != pendingInserts.begin()) {
+      --it;
+      if (it->second.contains(ptr)) {
+        return it->second.mem;
+      }
+    }
+    const dim_t index = findEntry(*entries, ptr);
+    if ((index < 0) ||
+        pendingErases.count((*entries)[index].start)) {
+      return NULL;
+    }
+    return (*entries)[index].mem;
+  }
+
+  occa::memory_v* ptrRangeMap::find(const void *ptr) {
+    if (OCCA_UVA_LOCK_READS) {
+      writeMutex.lock();
+      occa::memory_v *mem = findPending((const char*) ptr);
+      writeMutex.unlock();
+      return mem;
+    }
+
+    // The first lookup after a batch of updates publishes them, later
+    //   lookups don't lock until the next update
+    if (OCCA_UVA_ATOMIC_LOAD(isDirty)) {
+      writeMutex.lock();
+      publish();
+      writeMutex.unlock();
+    }
+
+    // Readers are counted before loading [entries] so publish() won't
+    //   free an array still being searched
+    OCCA_UVA_ATOMIC_ADD(activeReaders, 1);
+    const entryVector &entries_ = *OCCA_UVA_ATOMIC_LOAD(entries);
+    const dim_t index = findEntry(entries_, (const char*) ptr);
+    occa::memory_v *mem = ((index >= 0) ? entries_[index].mem : NULL);
+    OCCA_UVA_ATOMIC_ADD(activeReaders, -1);
+
+    return mem;
+  }
+
+  size_t ptrRangeMap::size() {
+    writeMutex.lock();
+    publish();
+    const size_t ret = entries->size();
+    writeMutex.unlock();
+    return ret;
+  }
+  //====================================
+
   uvaPtrInfo::uvaPtrInfo() :
     mem(NULL) {}
 
   uvaPtrInfo::uvaPtrInfo(void *ptr) {
-    ptrRangeMap::iterator it = uvaMap.find(ptr);
+    mem = uvaMap.find(ptr);
 
-    if (it != uvaMap.end()) {
-      mem = (it->second);
-    } else {
+    if (mem == NULL) {
       mem = (occa::memory_v*) ptr; // Defaults to ptr being a memory_v
     }
   }
@@ -95,8 +282,7 @@ namespace occa {
   }
 
   occa::memory_v* uvaToMemory(void *ptr) {
-    ptrRangeMap::iterator it = uvaMap.find(ptr);
-    return (it == uvaMap.end()) ? NULL : it->second;
+    return uvaMap.find(ptr);
   }
 
   void startManaging(void *ptr) {
@@ -167,12 +353,12 @@ namespace occa {
   }
 
   void removeFromStaleMap(void *ptr) {
-    ptrRangeMap::iterator it = uvaMap.find(ptr);
-    if (it == uvaMap.end()) {
+    occa::memory_v *mem = uvaMap.find(ptr);
+    if (mem == NULL) {
       return;
     }
 
-    memory m(it->second);
+    memory m(mem);
     if (!m.uvaIsStale()) {
       return;
     }
@@ -180,25 +366,44 @@ namespace occa {
     removeFromStaleMap(m.getMHandle());
   }
 
+  void addToStaleMap(memory_v *mem) {
+    if (mem->staleIndex < 0) {
+      mem->staleIndex = (int) uvaStaleMemory.size();
+      uvaStaleMemory.push_back(mem);
+    }
+    mem->memInfo |= uvaFlag::isStale;
+  }
+
   void removeFromStaleMap(memory_v *mem) {
-    occa::memory m(mem);
-    const size_t staleEntries = uvaStaleMemory.size();
-
-    for (size_t i = 0; i < staleEntries; ++i) {
-      if (uvaStaleMemory[i] == mem) {
-        m.uvaMarkFresh();
-        uvaStaleMemory.erase(uvaStaleMemory.begin() + i);
-        break;
-      }
+    const int index = mem->staleIndex;
+    if (index < 0) {
+      return;
+    }
+
+    // Swap with the last entry to remove in O(1)
+    memory_v *last = uvaStaleMemory.back();
+    uvaStaleMemory[index] = last;
+    last->staleIndex = index;
+    uvaStaleMemory.pop_back();
+
+    mem->staleIndex = -1;
+    mem->memInfo &= ~uvaFlag::isStale;
+  }
+
+  void markDirty(void *ptr, const udim_t bytes) {
+    occa::memory_v *mem = uvaToMemory(ptr);
+    if (mem) {
+      occa::memory(mem).markDirty(ptrDiff(mem->uvaPtr, ptr),
+                                  (dim_t) bytes);
     }
   }
 
   void free(void *ptr) {
-    ptrRangeMap::iterator it = uvaMap.find(ptr);
+    occa::memory_v *mem = uvaMap.find(ptr);
 
-    if ((it != uvaMap.end()) &&
-        (((void*) it->first.start) != ((void*) it->second))) {
-      occa::memory(it->second).free();
+    if ((mem != NULL) &&
+        (((void*) mem) != ptr)) {
+      occa::memory(mem).free();
     } else {
       ::free(ptr);
     }